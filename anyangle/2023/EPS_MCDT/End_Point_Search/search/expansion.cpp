@@ -95,17 +95,17 @@ double get_interval_heuristic(const Point& root, const Point& l, const Point& r)
 #define normalise(index) (index) - ((index) >= N ? N : 0)
 // Assume that there exists at least one element within the range which
 // satisifies the predicate.
-template<typename Type, typename Pred>
-inline int binary_search(const std::vector<int>& arr, const int N,
-                         const std::vector<Type>& objects, int lower, int upper,
-                         const Pred pred, const bool is_upper_bound)
+// pred is given the normalised index.
+template<typename Pred>
+inline int binary_search_index(const int N, int lower, int upper,
+                               const Pred pred, const bool is_upper_bound)
 {
     if (lower == upper) return lower;
     int best_so_far = -1;
     while (lower <= upper)
     {
         const int mid = lower + (upper - lower) / 2;
-        const bool matches_pred = pred(objects[arr[normalise(mid)]]);
+        const bool matches_pred = pred(normalise(mid));
         if (matches_pred)
         {
             best_so_far = mid;
@@ -133,6 +133,16 @@ inline int binary_search(const std::vector<int>& arr, const int N,
     return best_so_far;
 }
 
+template<typename Type, typename Pred>
+inline int binary_search(const std::vector<int>& arr, const int N,
+                         const std::vector<Type>& objects, int lower, int upper,
+                         const Pred pred, const bool is_upper_bound)
+{
+    return binary_search_index(N, lower, upper,
+        [&](const int index) { return pred(objects[arr[index]]); },
+        is_upper_bound);
+}
+
 // TODO: Wrap this in a class so we don't have to keep passing the same params
 // over and over again
 // Generates the successors of the search node and sets them in the successor
@@ -493,17 +503,52 @@ int get_successors(SearchNode& node, const Point& start, const Mesh& mesh,
 
     assert(V[normalise(left_ind)] == node.left_vertex);
 
-    // Find whether we can turn at either endpoint.
-    const Vertex& right_vertex_obj = mesh_vertices[node.right_vertex];
-    const Vertex& left_vertex_obj  = mesh_vertices[V[normalise(left_ind)]];
+    // The polygon's own copy of its coordinates. Its vertices are
+    // scattered over mesh_vertices, so this is where we get every point
+    // from, and mesh_vertices is only looked at to see if we can turn.
+    const double* xs =
+        &mesh.polygon_coords[mesh.polygon_points[node.next_polygon]];
+    const double* ys = xs + N;
 
-    const Point& right_p = right_vertex_obj.p;
-    const Point& left_p  = left_vertex_obj.p;
+    // Macro for getting a point from a polygon point index.
+    #define index2point(index) Point{xs[index], ys[index]}
+
+    const Point right_p = index2point(right_ind);
+    const Point left_p  = index2point(normalise(left_ind));
     const bool right_lies_vertex = right_p == node.right;
     const bool left_lies_vertex  = left_p == node.left;
-
-    // Macro for getting a point from a polygon point index.
-    #define index2point(index) mesh_vertices[V[index]].p
+    // Find whether we can turn at either endpoint.
+    const bool right_is_corner = right_lies_vertex &&
+        mesh_vertices[node.right_vertex].is_corner;
+    const bool left_is_corner = left_lies_vertex &&
+        mesh_vertices[node.left_vertex].is_corner;
+
+    // Which side of each ray every vertex of the polygon is on, from
+    // root_right * (v - right) and root_left * (v - left), computed for
+    // the whole polygon at once. The binary searches below decide A and
+    // B on these values, so the successors are the same as when they
+    // were computed one at a time. Polygons too big for the buffers are
+    // still done one at a time.
+    const Point root_right = node.right - root;
+    const Point root_left = node.left - root;
+    const int MAX_BATCH = 64;
+    const bool batched = N <= MAX_BATCH;
+    double right_side[MAX_BATCH], left_side[MAX_BATCH];
+    if (batched)
+    {
+        cross_batch(xs, ys, N, node.right, root_right, right_side);
+        cross_batch(xs, ys, N, node.left, root_left, left_side);
+    }
+    const auto right_side_of = [&](const int index)
+    {
+        return batched ? right_side[index] :
+               root_right * (index2point(index) - node.right);
+    };
+    const auto left_side_of = [&](const int index)
+    {
+        return batched ? left_side[index] :
+               root_left * (index2point(index) - node.left);
+    };
 
     // find the transition between non-observable-right and observable.
     // we will call this A, defined by:
@@ -512,26 +557,23 @@ int get_successors(SearchNode& node, const Point& start, const Mesh& mesh,
     // upper bound is left.
     // the "transition" will lie in the range [A-1, A)
 
-    const Point root_right = node.right - root;
     const int A = [&]()
     {
         if (right_lies_vertex)
         {
             // Check whether root-right-right+1 is collinear or CCW.
-            if (root_right *
-                (index2point(normalise(right_ind + 1)) - node.right) >
-                -EPSILON)
+            if (right_side_of(normalise(right_ind + 1)) > -EPSILON)
             {
                 // Intersects at right, so...
                 // we should use right_ind+1!
                 return right_ind + 1;
             }
         }
-        return binary_search(V, N, mesh_vertices, right_ind + 1, left_ind,
-            [&root_right, &node](const Vertex& v)
+        return binary_search_index(N, right_ind + 1, left_ind,
+            [&right_side_of](const int index)
             {
                 // STRICTLY CCW.
-                return root_right * (v.p - node.right) > EPSILON;
+                return right_side_of(index) > EPSILON;
             }, false
         );
     }();
@@ -539,8 +581,8 @@ int get_successors(SearchNode& node, const Point& start, const Mesh& mesh,
     const int normalised_A = normalise(A),
               normalised_Am1 = normalise(A-1);
 
-    const Point& A_p = index2point(normalised_A);
-    const Point& Am1_p = index2point(normalised_Am1);
+    const Point A_p = index2point(normalised_A);
+    const Point Am1_p = index2point(normalised_Am1);
     const Point right_intersect = right_lies_vertex && A == right_ind + 1 ? node.right : line_intersect(A_p, Am1_p, root, node.right);
 
     // find the transition between observable and non-observable-left.
@@ -549,39 +591,36 @@ int get_successors(SearchNode& node, const Point& start, const Mesh& mesh,
     // lower-bound is A - 1 (in the same segment as A).
     // upper bound is left-1, as we don't want root-left-left.
     // the "transition" will lie in the range (B, B+1]
-    const Point root_left = node.left - root;
     const int B = [&]()
     {
         if (left_lies_vertex)
         {
             // Check whether root-left-left-1 is collinear or CW.
-            if (root_left *
-                (index2point(normalise(left_ind - 1)) - node.left) <
-                EPSILON)
+            if (left_side_of(normalise(left_ind - 1)) < EPSILON)
             {
                 // Intersects at left, so...
                 // we should use left_ind-1!
                 return left_ind - 1;
             }
         }
-        return binary_search(V, N, mesh_vertices, A - 1, left_ind - 1,
-            [&root_left, &node](const Vertex& v)
+        return binary_search_index(N, A - 1, left_ind - 1,
+            [&left_side_of](const int index)
             {
                 // STRICTLY CW.
-                return root_left * (v.p - node.left) < -EPSILON;
+                return left_side_of(index) < -EPSILON;
             }, true
         );
     }();
     assert(B != -1);
     const int normalised_B = normalise(B),
               normalised_Bp1 = normalise(B+1);
-    const Point& B_p = index2point(normalised_B);
-    const Point& Bp1_p = index2point(normalised_Bp1);
+    const Point B_p = index2point(normalised_B);
+    const Point Bp1_p = index2point(normalised_Bp1);
     const Point left_intersect = left_lies_vertex && B == left_ind - 1 ? node.left : line_intersect(B_p, Bp1_p, root, node.left);
 
     // Macro to update this_inde/last_ind.
     #define update_ind() last_ind = cur_ind++; if (cur_ind == N) cur_ind = 0
-    if (right_lies_vertex && right_vertex_obj.is_corner)
+    if (right_is_corner)
     {
         // Generate non-observable.
 
@@ -689,7 +728,7 @@ int get_successors(SearchNode& node, const Point& start, const Mesh& mesh,
         };
     }
 
-    if (left_lies_vertex && left_vertex_obj.is_corner)
+    if (left_is_corner)
     {
         // Generate non-observable from left_intersect to Bp1_p
         // if left_intersect != Bp1_p.
@@ -723,7 +762,7 @@ int get_successors(SearchNode& node, const Point& start, const Mesh& mesh,
 
     #undef update_ind
 
-    #undef index_to_point
+    #undef index2point
 
     return out;
 }
@@ -4,8 +4,122 @@
 #include <graph.h>
 #include <dijkstra.h>
 #include <stack>
+#include <cstdio>
+#include <cstring>
 namespace polyanya {
 
+// Binary graph files (native byte order, GRAPH_FILE_VERSION):
+//   GraphFileHeader
+//   int32 vertices[V + 1]     offsets into out_vertices
+//   int32 out_vertices[E]
+//   double x, y per vertex
+namespace
+{
+    const char GRAPH_FILE_MAGIC[8] = {'P', 'L', 'Y', 'V', 'G', 'R', 'P', 'H'};
+    const uint32_t GRAPH_FILE_VERSION = 1;
+
+    struct GraphFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        int32_t number_of_vertices;
+        int64_t number_of_edges;
+    };
+}
+
+    bool Graph::save_binary(const string &file_name, const vector<Point> &coordinates) const {
+        assert(coordinates.size() == (size_t) number_of_vertices);
+        assert(vertices.size() == (size_t) number_of_vertices + 1);
+        GraphFileHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic));
+        h.version = GRAPH_FILE_VERSION;
+        h.number_of_vertices = number_of_vertices;
+        h.number_of_edges = out_vertices.size();
+        vector<double> points;
+        points.reserve(2 * coordinates.size());
+        for (const Point &p : coordinates) {
+            points.push_back(p.x);
+            points.push_back(p.y);
+        }
+
+        // write next to the target and rename, so that a reader never sees
+        // a partly written graph.
+        const string tmp_name = file_name + ".tmp";
+        FILE *f = fopen(tmp_name.c_str(), "wb");
+        if (f == NULL) {
+            cerr << "cannot write graph to " << tmp_name << endl;
+            return false;
+        }
+        bool ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+                  fwrite(vertices.data(), sizeof(int), vertices.size(), f) == vertices.size() &&
+                  fwrite(out_vertices.data(), sizeof(int), out_vertices.size(), f) == out_vertices.size() &&
+                  fwrite(points.data(), sizeof(double), points.size(), f) == points.size();
+        ok = (fclose(f) == 0) && ok;
+        if (!ok || rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+            cerr << "failed writing graph to " << file_name << endl;
+            remove(tmp_name.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool Graph::load_binary(const string &file_name) {
+        FILE *f = fopen(file_name.c_str(), "rb");
+        if (f == NULL) {
+            return false;
+        }
+        GraphFileHeader h;
+        bool ok = fread(&h, sizeof(h), 1, f) == 1 &&
+                  memcmp(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic)) == 0 &&
+                  h.version == GRAPH_FILE_VERSION &&
+                  h.number_of_vertices >= 0 && h.number_of_edges >= 0 &&
+                  h.number_of_edges <= INT32_MAX;
+        vector<int> v, out;
+        vector<double> points;
+        if (ok) {
+            v.resize(h.number_of_vertices + 1);
+            out.resize(h.number_of_edges);
+            points.resize(2 * (size_t) h.number_of_vertices);
+            ok = fread(v.data(), sizeof(int), v.size(), f) == v.size() &&
+                 fread(out.data(), sizeof(int), out.size(), f) == out.size() &&
+                 fread(points.data(), sizeof(double), points.size(), f) == points.size() &&
+                 fgetc(f) == EOF;
+        }
+        fclose(f);
+        ok = ok && v[0] == 0 && v.back() == h.number_of_edges;
+        for (int i = 0; ok && i < h.number_of_vertices; i++) {
+            ok = v[i] <= v[i + 1];
+        }
+        for (size_t i = 0; ok && i < out.size(); i++) {
+            ok = out[i] >= 0 && out[i] < h.number_of_vertices;
+        }
+        if (!ok) {
+            cerr << file_name << " is not a version " << GRAPH_FILE_VERSION
+                 << " graph file" << endl;
+            return false;
+        }
+
+        number_of_vertices = h.number_of_vertices;
+        number_of_edges = h.number_of_edges;
+        vertices.swap(v);
+        out_vertices.swap(out);
+        distance_cost.resize(number_of_edges);
+        int max_degree = 0;
+        for (int i = 0; i < number_of_vertices; i++) {
+            const Point p = {points[2 * i], points[2 * i + 1]};
+            for (int arc = vertices[i]; arc < vertices[i + 1]; arc++) {
+                const int j = out_vertices[arc];
+                distance_cost[arc] = p.distance({points[2 * j], points[2 * j + 1]});
+            }
+            max_degree = std::max(max_degree, vertices[i + 1] - vertices[i]);
+        }
+        if(max_degree > 4096){
+            cout<<"Degree is larger than CPD setting! Probably you can resolve this by cutting necessary first move during the preprocessing "<<endl;
+        }
+        return true;
+    }
+
     void Graph::load_graph(const string &file_name) {
         ifstream in(file_name);
         vector<vector<double>> lines;
@@ -50,6 +50,12 @@ namespace polyanya {
 
         void load_graph(const string &file_name);
 
+        // Binary graph files hold the CSR arrays and the position of every
+        // vertex. Edge costs are not stored; they are the distances
+        // between those positions and are recomputed by load_binary.
+        bool save_binary(const string &file_name, const vector<Point> &coordinates) const;
+        bool load_binary(const string &file_name);
+
         vector<int> generate_DFS_ordering();
 
         void resort_graph(const vector<int> &ordering);
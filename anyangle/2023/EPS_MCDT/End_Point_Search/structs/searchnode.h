@@ -35,6 +35,10 @@ struct SearchNode
     int goal_id = -1;
     int heuristic_gid = -1;
     int edge_id = -1;
+    // position in a NodeQueue, -1 if not in one
+    int heap_index = -1;
+    // the node pushed before this one with the same root
+    SearchNode* same_root = nullptr;
 
 
 
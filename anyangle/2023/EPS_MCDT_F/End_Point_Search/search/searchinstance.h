@@ -3,7 +3,8 @@
 #include "successor.h"
 #include "mesh.h"
 #include "point.h"
-#include "cpool.h"
+#include "arena.h"
+#include "node_queue.h"
 #include <queue>
 #include <vector>
 #include <ctime>
@@ -28,22 +29,24 @@ namespace polyanya
 // Polyanya instance for point to point search
     class SearchInstance
     {
-        typedef std::priority_queue<SearchNodePtr, std::vector<SearchNodePtr>,
-                PointerComp<SearchNode> > pq;
     private:
-        warthog::mem::cpool* node_pool;
+        // nodes live until the next search; see init_search
+        warthog::mem::arena* node_pool;
         MeshPtr mesh;
         Point start, goal;
 
         SearchNodePtr final_node;
         int end_polygon; // set by init_search
-        pq open_list;
+        NodeQueue open_list;
 
         // Best g value for a specific vertex.
         std::vector<double> root_g_values;
         // Contains the current search id if the root has been reached by
         // the search.
         std::vector<int> root_search_ids;  // also used for root-level pruning
+        // The nodes pushed with each root, as lists through
+        // SearchNode::same_root. Valid once the root has been reached.
+        std::vector<SearchNodePtr> root_nodes;
 
         int search_id;
 
@@ -57,7 +60,7 @@ namespace polyanya
             verbose = false;
             search_successors = new Successor [mesh->max_poly_sides + 2];
             search_nodes_to_push = new SearchNode [mesh->max_poly_sides + 2];
-            node_pool = new warthog::mem::cpool(sizeof(SearchNode));
+            node_pool = new warthog::mem::arena(sizeof(SearchNode));
             init_root_pruning();
         }
         void init_root_pruning()
@@ -67,14 +70,15 @@ namespace polyanya
             size_t num_vertices = mesh->mesh_vertices.size();
             root_g_values.resize(num_vertices);
             root_search_ids.resize(num_vertices);
+            root_nodes.resize(num_vertices);
             fill(root_search_ids.begin(), root_search_ids.end(), 0);
         }
         void init_search()
         {
             assert(node_pool);
-            node_pool->reclaim();
+            node_pool->reset();
             search_id++;
-            open_list = pq();
+            open_list.clear();
             final_node = nullptr;
             nodes_generated = 0;
             nodes_pushed = 0;
@@ -87,6 +91,7 @@ namespace polyanya
 
         void set_end_polygon();
         void gen_initial_nodes();
+        bool push(SearchNodePtr node);
         int succ_to_node(
                 SearchNodePtr parent, Successor* successors,
                 int num_succ, SearchNode* nodes
@@ -95,7 +100,8 @@ namespace polyanya
 
     public:
         int nodes_generated;        // Nodes stored in memory
-        int nodes_pushed;           // Nodes pushed onto open
+        int nodes_pushed;           // Nodes pushed onto open (less those
+                                    // an equal open node made redundant)
         int nodes_popped;           // Nodes popped off open
         int nodes_pruned_post_pop;  // Nodes we prune right after popping off
         int successor_calls;        // Times we call get_successors
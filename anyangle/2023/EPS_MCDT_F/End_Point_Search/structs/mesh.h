@@ -9,6 +9,8 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <stdint.h>
+#include <string>
 
 
 namespace polyanya
@@ -206,9 +208,40 @@ namespace polyanya
         std::map<double, std::vector<int>> slabs;
         double min_x, max_x, min_y, max_y;
 
+        // Point location tables for meshes whose vertices all lie on the
+        // integer lattice, which is every mesh built from a grid.
+        // grid_vertex_locations holds, for each lattice point in
+        // [min_x, max_x] x [min_y, max_y] (row by row), an index into
+        // grid_locations. grid_cell_polygons holds, for each unit cell,
+        // the polygon containing its whole interior, -1 if the cell is not
+        // on the mesh or GRID_CELL_SPLIT if an edge crosses it. Both are
+        // null for other meshes, which only use the slabs. They point into
+        // grid_storage, or straight into the mapped file when the mesh was
+        // loaded with load_binary.
+        static const int GRID_CELL_SPLIT = -2;
+        int grid_cols = 0, grid_rows = 0;
+        std::vector<PointLocation> grid_locations;
+        std::vector<int> grid_storage;
+        const int* grid_vertex_locations = nullptr;
+        const int* grid_cell_polygons = nullptr;
+
+        // The file mapped by load_binary, if any.
+        void* mapping = nullptr;
+        size_t mapping_size = 0;
+
     public:
+        // Binary mesh files hold everything read and precomputed for a
+        // mesh as flat arrays, so that loading one is a single mmap and a
+        // few bulk copies instead of parsing the text format and rebuilding
+        // the slabs, edges and point location tables. See mesh.cpp for the
+        // layout.
+        static const uint32_t BINARY_VERSION = 1;
+
         Mesh() { }
         Mesh(std::istream& infile);
+        ~Mesh();
+        Mesh(const Mesh&) = delete;
+        Mesh& operator=(const Mesh&) = delete;
         std::vector<Vertex> mesh_vertices;
         std::vector<Polygon> mesh_polygons;
         std::vector<Edge> mesh_edges;
@@ -218,16 +251,27 @@ namespace polyanya
         std::vector<int> cpd_to_vertices_mapper;
         std::vector<std::vector<int>> cpd_out_vertices;
         std::vector<std::vector<double>> cpd_distance_cost;
+        // The vertex coordinates of every polygon, so that get_successors
+        // can test a whole polygon at once without going through
+        // mesh_vertices. Those of polygon p start at polygon_points[p]:
+        // its N x coordinates in order, then its N y coordinates.
+        std::vector<int> polygon_points;
+        std::vector<double> polygon_coords;
         int max_poly_sides;
         int width;
         int height;
 
         void read(std::istream& infile);
+        bool save_binary(const std::string& filename) const;
+        bool load_binary(const std::string& filename);
         void precalc_point_location();
+        void precalc_grid_point_location();
+        void precalc_polygon_points();
         void print(std::ostream& outfile);
         void print_vertex();
         PolyContainment poly_contains_point(int poly, Point& p);
         PointLocation get_point_location(Point& p);
+        PointLocation get_point_location_slab(Point& p);
         PointLocation get_point_location_naive(Point& p);
 
         void print_polygon(std::ostream& outfile, int index);
@@ -51,4 +51,13 @@ bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path);
 
 std::string GetName();
 
+/*
+optional forms of PreprocessMap and PrepareForSearch that take the map packed into
+64-bit words (see GPPC::BitGrid), for engines that copy it by the word or read it in
+place. the grid stays valid until the program exits. when an entry defines them,
+they are called instead of the std::vector<bool> forms.
+*/
+void PreprocessMap(const GPPC::BitGrid &grid, const std::string &filename) __attribute__((weak));
+void *PrepareForSearch(const GPPC::BitGrid &grid, const std::string &filename) __attribute__((weak));
+
 #endif // GPPC_AA_ENTRY_H
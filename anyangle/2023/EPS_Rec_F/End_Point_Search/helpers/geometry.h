@@ -20,6 +20,14 @@ inline Point line_intersect(const Point& a, const Point& b,
     return a + ab * (((c - a) * (d - a)) / (ab * (d - c)));
 }
 
+// Sets out[i] = d * (Point{xs[i], ys[i]} - o) for every i < n: which
+// side of the ray from o along d each point is on. The results are the
+// same, bit for bit, as evaluating the expression one point at a time,
+// but four points are done at once on CPUs with AVX (unless built with
+// POLYANYA_NO_SIMD).
+void cross_batch(const double* xs, const double* ys, int n,
+                 const Point& o, const Point& d, double* out);
+
 inline bool onsegment(const Point& c, const Point& s_1, const Point& s_2){
     double seg_distance = s_1.distance(s_2);
     return s_1.distance(c) < seg_distance && s_2.distance(c) < seg_distance;
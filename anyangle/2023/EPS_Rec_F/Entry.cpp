@@ -48,42 +48,64 @@ pl::MeshPtr mp;
 pl::CPDPtr cpd;
 
 
-void output_graph(const std::vector<vector<int>>& visibility_graph, const std::vector<vector<double>>& graph_weight,
-                  const std::vector<pl::Point>& coordinate,const std::vector<int>& vertice_mapper,string output_file)
+// Drop the vertices hidden behind a closer one on the same ray from
+// @param source_point. @param visible_vertices must be sorted by distance
+// from the source; their order is kept.
+//
+// The vertices are sorted by direction once, so that collinear ones are
+// adjacent and only the nearest of each run is kept.
+void remove_collinear_vertices(const pl::Point& source_point, const vector<pl::Vertex>& mesh_vertices,
+                               std::vector<int>& visible_vertices)
 {
-    std::cout<<"Saving graph to"<<output_file<<std::endl;
-    std::ofstream outputFile(output_file);
-    outputFile <<coordinate.size()<<"\n";
-    int number_of_edges = 0 ;
-    for(const vector<int>& vertices : visibility_graph){
-        for(const int & edge : vertices){
-            number_of_edges ++;
-        }
+    const int n = visible_vertices.size();
+    std::vector<pl::Point> dir(n);
+    std::vector<int> by_angle(n);
+    for (int i = 0; i < n; i++) {
+        dir[i] = mesh_vertices[visible_vertices[i]].p - source_point;
+        by_angle[i] = i;
     }
-    outputFile <<number_of_edges<<"\n";
-    for(int v_id = 0; v_id < visibility_graph.size(); v_id ++){
-        for(int e_id= 0; e_id < visibility_graph[v_id].size(); e_id ++){
-            outputFile<<std::fixed<<setprecision(8) <<v_id<<" "<<visibility_graph[v_id][e_id]<<" "<<graph_weight[v_id][e_id]<<"\n";
+    // upper half plane first, then counter clockwise; ties by distance.
+    const auto upper = [](const pl::Point& d) { return d.y > 0 || (d.y == 0 && d.x > 0); };
+    std::sort(by_angle.begin(), by_angle.end(), [&](int a, int b) -> bool {
+        if (upper(dir[a]) != upper(dir[b])) {
+            return upper(dir[a]);
+        }
+        const double cross = dir[a] * dir[b];
+        if (cross != 0) {
+            return cross > 0;
+        }
+        return a < b;
+    });
+    std::vector<bool> removed(n, false);
+    for (int i = 0; i < n;) {
+        // the run of vertices on the ray through by_angle[i]; its nearest
+        // vertex is the one with the lowest index.
+        const int first = by_angle[i];
+        int nearest = first;
+        int j = i + 1;
+        for (; j < n; j++) {
+            const int cur = by_angle[j];
+            if (upper(dir[cur]) != upper(dir[first]) ||
+                get_orientation(source_point, mesh_vertices[visible_vertices[first]].p,
+                                mesh_vertices[visible_vertices[cur]].p) != pl::Orientation::COLLINEAR) {
+                break;
+            }
+            nearest = std::min(nearest, cur);
+        }
+        for (int k = i; k < j; k++) {
+            removed[by_angle[k]] = by_angle[k] != nearest;
         }
+        i = j;
     }
-    outputFile.close();
-
-    size_t lastindex = output_file.find_last_of(".");
-    string rawname = output_file.substr(0, lastindex);
-
-    std::ofstream coordinateFile(rawname+".cor");
-    int id = 0;
-    for(pl::Point cor:coordinate){
-        coordinateFile<<std::fixed<<setprecision(8)<<id<<" "<<cor.x<<" "<<cor.y<<"\n";
-        id++;
+    int kept = 0;
+    for (int i = 0; i < n; i++) {
+        if (!removed[i]) {
+            visible_vertices[kept++] = visible_vertices[i];
+        }
     }
-
-    save_vector(rawname+".vMapper",vertice_mapper);
-    std::cout<<"done"<<std::endl;
+    visible_vertices.resize(kept);
 }
 
-
-
 void build_visiblity_graph(string mesh_path, string output_path, const vector<bool> &map, int input_width, int input_height){
     std::cout<<"Building visibility graph ..."<<std::endl;
     ifstream meshfile(mesh_path);
@@ -123,65 +145,44 @@ void build_visiblity_graph(string mesh_path, string output_path, const vector<bo
     for (int i = 0; i < omp_get_max_threads(); i ++){
         visibility_search.push_back(new pl::visibleSearchInstance(mp));
     }
-    std::vector<vector<int>> visibility_graph;
     int number_of_vertices = turning_vertices.size();
+    // the visible vertices of each source, in source order whichever
+    // thread finds them.
+    std::vector<vector<int>> visibility_graph(number_of_vertices);
     {
         printf("Using %d threads\n", omp_get_max_threads());
-        std::vector<std::vector<vector<int>>>thread_graph(omp_get_max_threads());
 
         int progress = 0;
 
+        // visibility costs vary a lot between turning vertices, so hand
+        // them out in small batches rather than fixed ranges.
 #pragma omp parallel
         {
-            const int thread_count = omp_get_num_threads();
             const int thread_id = omp_get_thread_num();
-//            const int begin_int  = 0;
-            const int node_count =number_of_vertices;
-
-            int node_begin = (node_count*thread_id) / thread_count ;
-            int node_end = (node_count*(thread_id+1)) / thread_count ;
             pl::visibleSearchInstance& thread_dij = *visibility_search[thread_id];
 
-            for(int source_node=node_begin; source_node < node_end; ++source_node){
+#pragma omp for schedule(dynamic, 16)
+            for(int source_node=0; source_node < number_of_vertices; ++source_node){
 
                 int source = turning_vertices[source_node];
                 pl::Point source_point = mesh_vertices[source].p;
-                auto comp = [&](int v1,int v2)-> bool {
-                    double d1 =source_point.distance(mesh_vertices[v1].p);
-                    double d2 = source_point.distance(mesh_vertices[v2].p);
-                    if(d1<d2){
-                        return true;
-                    }else if(d1 == d2){
-                        return v1 < v2;
-                    }else{
-                        return false;
-                    }
-                };
-                std::vector<int> visible_vertices;
+                std::vector<int>& visible_vertices = visibility_graph[source_node];
                 thread_dij.search_visible_vertices(
                         turning_vertices[source_node],turning_vertices_location[source_node],visible_vertices);
                 if(!visible_vertices.empty()) {
                     // it's possible to be empty;
-                    sort(visible_vertices.begin(), visible_vertices.end(), comp);
-                    for (int cur = 0; cur < visible_vertices.size() - 1; cur++) {
-                        vector<int> remove_list;
-                        const pl::Point &cur_point = mesh_vertices[visible_vertices[cur]].p;
-                        for (int next = cur + 1; next < visible_vertices.size(); next++) {
-                            //remove the collinear edges;
-                            const pl::Point &next_point = mesh_vertices[visible_vertices[next]].p;
-                            if (get_orientation(source_point, cur_point, next_point) == pl::Orientation::COLLINEAR &&
-                                source_point.distance(next_point) > cur_point.distance(next_point)) {
-                                remove_list.push_back(next);
-                            }
-                        }
-                        int index = 0;
-                        for (int rm: remove_list) {
-                            visible_vertices.erase(visible_vertices.begin() + rm - index);
-                            index++;
-                        }
+                    std::vector<std::pair<double, int>> by_distance;
+                    by_distance.reserve(visible_vertices.size());
+                    for (int v: visible_vertices) {
+                        by_distance.push_back({source_point.distance(mesh_vertices[v].p), v});
+                    }
+                    sort(by_distance.begin(), by_distance.end());
+                    for (size_t i = 0; i < by_distance.size(); i++) {
+                        visible_vertices[i] = by_distance[i].second;
                     }
+                    //remove the collinear edges;
+                    remove_collinear_vertices(source_point, mesh_vertices, visible_vertices);
                 }
-                thread_graph[thread_id].push_back(visible_vertices);
 
 
 #pragma omp critical
@@ -197,12 +198,6 @@ void build_visiblity_graph(string mesh_path, string output_path, const vector<bo
             }
         }
 
-        for(auto&x:thread_graph){
-            for(auto&y:x){
-                visibility_graph.push_back(y);
-            }
-        }
-
     }
     for (auto i: visibility_search) delete i;
 
@@ -211,20 +206,32 @@ void build_visiblity_graph(string mesh_path, string output_path, const vector<bo
     for(int i = 0; i < turning_vertices.size(); i ++){
         vertice_mapper[turning_vertices[i]] = i;
     }
-    std::vector<vector<double>> graph_weight(visibility_graph.size());
-    for(int i = 0; i < visibility_graph.size(); i++){
-        graph_weight[i].resize(visibility_graph[i].size());
-        for(int j = 0; j < visibility_graph[i].size(); j++){
-            double distance = mesh_vertices[turning_vertices[i]].p.distance(mesh_vertices[visibility_graph[i][j]].p);
-            if(distance == 0){
+    pl::Graph g;
+    g.number_of_vertices = number_of_vertices;
+    g.vertices.resize(number_of_vertices + 1);
+    g.vertices[0] = 0;
+    size_t number_of_edges = 0;
+    for(const vector<int>& visible_vertices : visibility_graph){
+        number_of_edges += visible_vertices.size();
+    }
+    g.out_vertices.reserve(number_of_edges);
+    for(int i = 0; i < number_of_vertices; i++){
+        g.vertices[i + 1] = g.vertices[i] + visibility_graph[i].size();
+        for(int v : visibility_graph[i]){
+            if(mesh_vertices[turning_vertices[i]].p.distance(mesh_vertices[v].p) == 0){
                 std::cout<<"distance should not be 0 "<< std::endl;
             }
-            graph_weight[i][j]= distance;
-            visibility_graph[i][j] = vertice_mapper[visibility_graph[i][j]];
+            g.out_vertices.push_back(vertice_mapper[v]);
         }
+        vector<int>().swap(visibility_graph[i]);
     }
+    g.number_of_edges = g.out_vertices.size();
+    std::cout<<"done"<<std::endl;
+    std::cout<<"Saving graph to "<<output_path<<std::endl;
+    g.save_binary(output_path, turning_point);
+    size_t lastindex = output_path.find_last_of(".");
+    save_vector(output_path.substr(0, lastindex)+".vMapper",vertice_mapper);
     std::cout<<"done"<<std::endl;
-    output_graph(visibility_graph,graph_weight,turning_point, vertice_mapper,output_path);
     std::cout<<std::endl;
 }
 
@@ -233,7 +240,7 @@ void construct_cpd(const string& input_file, const string& output_file) {
 
 
     pl::Graph g = pl::Graph();
-    g.load_graph(input_file);
+    g.load_binary(input_file);
     // only need free flow cost;
     std::cout<<"Loading visibility graph ...."<<std::endl;
     vector<int> dfs_ordering =g.generate_DFS_ordering();
@@ -336,8 +343,9 @@ void PreprocessMap(const std::vector<bool> &bits, int width, int height, const s
 //
 
     convertgrid2rect(bits, width, height,filename+".merged-mesh");
-    build_visiblity_graph(filename+".merged-mesh", filename+".vis",bits, width, height);
-    construct_cpd(filename+".vis",filename);
+    build_visiblity_graph(filename+".merged-mesh", filename+".vis-bin",bits, width, height);
+    mp->save_binary(filename+".mesh-bin");
+    construct_cpd(filename+".vis-bin",filename);
 //        grid2poly::convertGrid2Poly(bits, width, height,filename+".merged-mesh");
 //        mesh2merged::convertMesh2MergedMesh(filename+".mesh",filename+".merged-mesh");
 //        convertMesh2MergedMesh(filename+".mesh",filename+".merged-mesh");
@@ -361,17 +369,25 @@ void PreprocessMap(const std::vector<bool> &bits, int width, int height, const s
  * @returns Pointer to data-structure used for search.  Memory should be stored on heap, not stack.
  */
 void *PrepareForSearch(const vector<bool> &bits, int width, int height, const string &filename) {
-    string mesh_path = filename+".merged-mesh";
-    ifstream meshfile(mesh_path);
-    mp = new pl::Mesh(meshfile);
-    mp->pre_compute_obstacle_edge_on_vertex();
-    mp->mark_turning_point(bits, width, height);
+    mp = new pl::Mesh();
+    if (!mp->load_binary(filename+".mesh-bin")) {
+        // preprocessed before binary meshes existed
+        delete mp;
+        string mesh_path = filename+".merged-mesh";
+        ifstream meshfile(mesh_path);
+        mp = new pl::Mesh(meshfile);
+        mp->pre_compute_obstacle_edge_on_vertex();
+        mp->mark_turning_point(bits, width, height);
+    }
 
     string vertices_mapper_path =filename+".vMapper";
     string cpd_mapper_path =filename+".mapper";
-    string visibility_graph_path =filename+".vis";
+    string visibility_graph_path =filename+".vis-bin";
     pl::Graph g = pl::Graph();
-    g.load_graph(visibility_graph_path);
+    if (!g.load_binary(visibility_graph_path)) {
+        // preprocessed before binary graphs existed
+        g.load_graph(filename+".vis");
+    }
     vector<int> vertices_mapper = load_vector<int>(vertices_mapper_path);
     vector<int> cpd_mapper = load_vector<int>(cpd_mapper_path);
     mp->create_cpd_to_vertices_mapper(vertices_mapper,cpd_mapper);
@@ -43,6 +43,21 @@ void *PrepareForSearch( const std::vector<bool> &bits, int width, int height, co
     return solver;
 }
 
+/**
+ * Form of `PreprocessMap` taking the map packed into words, see Entry.h.
+ */
+void PreprocessMap( const GPPC::BitGrid &grid, const std::string &filename ) {}
+
+/**
+ * Form of `PrepareForSearch` taking the map packed into words, see Entry.h.
+ * The solver reads the grid in place instead of keeping a packed copy.
+ */
+void *PrepareForSearch( const GPPC::BitGrid &grid, const std::string &filename ) 
+{
+    GapSolver* solver = new GapSolver( grid.bits, grid.stride, grid.width, grid.height );
+    return solver;
+}
+
 /**
  * User code used to setup search before queries.  Can also load pre-processing data from file to speed load.
  * It will not be called in the same program execution as `PreprocessMap` is called,
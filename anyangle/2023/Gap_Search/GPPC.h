@@ -1,9 +1,85 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
+#include <vector>
 
 namespace GPPC {
   struct xyLoc {
     double x;
     double y;
   };
+  // a map packed one bit per tile (1: traversable) into 64-bit words, for the
+  // BitGrid forms of PreprocessMap and PrepareForSearch (see Entry.h).
+  // tile (x, y) is bit x % 64 of word x / 64 of row y and rows are stride words
+  // apart. every row ends with at least one padding bit and one padding row lies
+  // above the first row and below the last. padding is obstacles, so any tile
+  // just off the map, (-1, -1) included, reads as an obstacle.
+  struct BitGrid {
+    int width, height;
+    int stride;
+    const uint64_t *bits;        // row 0
+    // the same for the transposed map (width and height swapped, tile (x, y)
+    // in bit y of row x), or nullptr
+    int tstride;
+    const uint64_t *transposed;
+
+    const uint64_t *Row(int y) const { return bits + static_cast<ptrdiff_t>(y) * stride; }
+    bool Get(int x, int y) const { return (Row(y)[x >> 6] >> (x & 63)) & 1; }
+  };
+
+  // owns the words of a BitGrid; the harness fills it while loading the map
+  class PackedGrid {
+  public:
+    PackedGrid() { Resize(0, 0); }
+
+    // all tiles become obstacles
+    void Resize(int width, int height) {
+      grid.width = width;
+      grid.height = height;
+      grid.stride = width / 64 + 1;
+      grid.tstride = height / 64 + 1;
+      // one more word in front for tile (-1, -1)
+      words.assign(static_cast<size_t>(height + 2) * grid.stride + 1, 0);
+      twords.clear();
+      grid.bits = words.data() + 1 + grid.stride;
+      grid.transposed = nullptr;
+    }
+
+    void Set(int x, int y) {
+      words[1 + static_cast<size_t>(y + 1) * grid.stride + (x >> 6)] |= uint64_t(1) << (x & 63);
+    }
+
+    // fills in the transposed copy, 64x64 tiles at a time
+    void Transpose() {
+      twords.assign(static_cast<size_t>(grid.width + 2) * grid.tstride + 1, 0);
+      uint64_t block[64];
+      for (int by = 0; by < grid.height; by += 64)
+      for (int bx = 0; bx < grid.width; bx += 64) {
+        for (int i = 0; i < 64; i++)
+          block[i] = by + i < grid.height ? grid.Row(by + i)[bx >> 6] : 0;
+        Transpose64(block);
+        for (int i = 0; i < 64 && bx + i < grid.width; i++)
+          twords[1 + static_cast<size_t>(bx + i + 1) * grid.tstride + (by >> 6)] = block[i];
+      }
+      grid.transposed = twords.data() + 1 + grid.tstride;
+    }
+
+    const BitGrid &Grid() const { return grid; }
+
+  private:
+    // transposes a 64x64 bit matrix: bit j of a[i] swaps with bit i of a[j]
+    static void Transpose64(uint64_t a[64]) {
+      uint64_t m = 0x00000000FFFFFFFFull;
+      for (int j = 32; j != 0; j >>= 1, m ^= m << j) {
+        for (int k = 0; k < 64; k = (k + j + 1) & ~j) {
+          uint64_t t = ((a[k] >> j) ^ a[k + j]) & m;
+          a[k] ^= t << j;
+          a[k + j] ^= t;
+        }
+      }
+    }
+
+    BitGrid grid;
+    std::vector<uint64_t> words, twords;
+  };
 }
@@ -13,8 +13,16 @@
 
 class GapSolver
 {
+    private: 
+        // the occupancy matrix packed 64 cells to a word: cell (x,y) is bit x % 64 
+        // of rows[ y * stride + x / 64 ]. rows end with padding bits and have a 
+        // padding row above and below, all occupied, so that the neighbours of 
+        // any cell on the map can be read without bounds checks 
+        std::vector< uint64_t > packed; 
+        const uint64_t* rows; 
+        ptrdiff_t stride; 
+
     public: 
-        const std::vector< bool > & occupancy;
         size_t Nx, Ny;  
 
     private: 
@@ -61,8 +69,15 @@ class GapSolver
 
     public: 
         GapSolver( const std::vector< bool > & occupancy_, const size_t nx_, const size_t ny_ );
+        // rows_ is used in place and laid out as described for rows above 
+        GapSolver( const uint64_t* rows_, const size_t stride_, const size_t nx_, const size_t ny_ );
 
     private: 
+        bool traversable( const int32_t x_, const int32_t y_ ) const 
+        { 
+            return ( rows[ y_ * stride + ( x_ >> 6 ) ] >> ( x_ & 63 ) ) & 1; 
+        }
+
         Vec2 current_position();
 
         bool frwd_up_blocked( const Vec2& ); 
@@ -112,8 +127,10 @@ class GapSolver
         void reset();
 };
 
-GapSolver::GapSolver( const std::vector< bool > & occupancy_, const size_t nx_, const size_t ny_ ) :
-    occupancy( occupancy_ ), 
+GapSolver::GapSolver( const uint64_t* rows_, const size_t stride_, const size_t nx_, const size_t ny_ ) :
+    packed(), 
+    rows( rows_ ), 
+    stride( static_cast< ptrdiff_t >( stride_ ) ), 
     Nx( nx_ ), Ny( ny_ ), 
     scene( nx_, ny_ ), 
     p0(),  
@@ -147,6 +164,18 @@ GapSolver::GapSolver( const std::vector< bool > & occupancy_, const size_t nx_,
     gap_seekers.reserve( 64 ); // a rough initial estimate
 }
 
+GapSolver::GapSolver( const std::vector< bool > & occupancy_, const size_t nx_, const size_t ny_ ) :
+    GapSolver( nullptr, nx_ / 64 + 1, nx_, ny_ )
+{
+    // one word in front for the cell at (-1,-1) 
+    packed.assign( ( ny_ + 2 ) * stride + 1, 0 ); 
+    rows = packed.data() + 1 + stride; 
+    for ( size_t y = 0; y < ny_; ++y )
+        for ( size_t x = 0; x < nx_; ++x )
+            if ( occupancy_[ y * nx_ + x ] )
+                packed[ 1 + ( y + 1 ) * stride + ( x >> 6 ) ] |= uint64_t( 1 ) << ( x & 63 );
+}
+
 Vec2 GapSolver::current_position()
 {
     return p0 + Vec2( x * x_sign, y * y_sign ); 
@@ -154,22 +183,22 @@ Vec2 GapSolver::current_position()
 
 bool GapSolver::frwd_up_blocked( const Vec2& pos_ )
 {
-    return ! occupancy[ ( pos_.y + up ) * Nx + ( pos_.x + forward ) ]; 
+    return ! traversable( pos_.x + forward, pos_.y + up ); 
 }
 
 bool GapSolver::frwd_dn_blocked( const Vec2& pos_ ) 
 {
-    return ! occupancy[ ( pos_.y + down ) * Nx + ( pos_.x + forward ) ]; 
+    return ! traversable( pos_.x + forward, pos_.y + down ); 
 }
 
 bool GapSolver::bkwd_up_blocked( const Vec2& pos_ ) 
 {
-    return ! occupancy[ ( pos_.y + up ) * Nx + ( pos_.x + backward ) ]; 
+    return ! traversable( pos_.x + backward, pos_.y + up ); 
 }
 
 bool GapSolver::bkwd_dn_blocked( const Vec2& pos_ ) 
 {
-    return ! occupancy[ ( pos_.y + down ) * Nx + ( pos_.x + backward ) ]; 
+    return ! traversable( pos_.x + backward, pos_.y + down ); 
 }
 
 void GapSolver::reset_search_state()
@@ -840,8 +869,8 @@ bool GapSolver::check_LoS_solution()
     }
     else 
     { 
-        bool bk_up_blocked = ( p0.x == 0 || p0.y == Ny || ! occupancy[ p0.y * Nx + ( p0.x - 1 ) ] );
-        bool fw_dn_blocked = ( p0.x == Nx || p0.y == 0 || ! occupancy[ ( p0.y - 1 ) * Nx + p0.x ] );
+        bool bk_up_blocked = ( p0.x == 0 || p0.y == Ny || ! traversable( p0.x - 1, p0.y ) );
+        bool fw_dn_blocked = ( p0.x == Nx || p0.y == 0 || ! traversable( p0.x, p0.y - 1 ) );
 
         start_OK = !( bk_up_blocked && fw_dn_blocked );
     }
@@ -864,8 +893,8 @@ bool GapSolver::check_solution_is_gppc_valid( const Vec2& from_pos_ )
     if ( rel_pos.x >= 0 && rel_pos.y >= 0 )
         return true; 
 
-    bool bk_up_blocked = ( goal.x == 0 || goal.y == Ny || ! occupancy[ goal.y * Nx + ( goal.x - 1 ) ] );
-    bool fw_dn_blocked = ( goal.x == Nx || goal.y == 0 || ! occupancy[ ( goal.y - 1 ) * Nx + goal.x ] );
+    bool bk_up_blocked = ( goal.x == 0 || goal.y == Ny || ! traversable( goal.x - 1, goal.y ) );
+    bool fw_dn_blocked = ( goal.x == Nx || goal.y == 0 || ! traversable( goal.x, goal.y - 1 ) );
 
     if ( bk_up_blocked && fw_dn_blocked )
         return false; 
@@ -1328,7 +1357,7 @@ bool GapSolver::LoS_OK( const Vec2& p0_, const Vec2& p1_ )
             if ( D > -dy )
             {
                 p = p0 + Vec2( x, y * _y_sign + y_shift );
-                if ( ! occupancy[ p.y * Nx + p.x ] )
+                if ( ! traversable( p.x, p.y ) )
                     return false; 
             }    
 
@@ -1337,7 +1366,7 @@ bool GapSolver::LoS_OK( const Vec2& p0_, const Vec2& p1_ )
         }   
 
         p = p0 + Vec2( x, y * _y_sign + y_shift ); 
-        if ( ! occupancy[ p.y * Nx + p.x ] )
+        if ( ! traversable( p.x, p.y ) )
             return false; 
         
         D -= dx; 
@@ -1345,7 +1374,7 @@ bool GapSolver::LoS_OK( const Vec2& p0_, const Vec2& p1_ )
         
         if ( D == -dy && y < dy )
         {
-            if ( ! occupancy[ p.y * Nx + ( p.x + 1 ) ] && ! occupancy[ ( p.y + _y_sign ) * Nx + p.x ] )
+            if ( ! traversable( p.x + 1, p.y ) && ! traversable( p.x, p.y + _y_sign ) )
                 return false; 
         }             
     }
@@ -1364,8 +1393,8 @@ bool GapSolver::LoS_OK_horizontal( const Vec2& p0_, const Vec2& p1_ )
 
     Vec2 f( 1, 0 );  
 
-    bool fu_blocked = ( p.y == Ny || ! occupancy[ p.y * Nx + p.x ] );
-    bool fd_blocked = ( p.y == 0  || ! occupancy[ ( p.y - 1 ) * Nx + p.x ] );
+    bool fu_blocked = ( p.y == Ny || ! traversable( p.x, p.y ) );
+    bool fd_blocked = ( p.y == 0  || ! traversable( p.x, p.y - 1 ) );
 
     if ( fu_blocked && fd_blocked )
         return false; 
@@ -1377,8 +1406,8 @@ bool GapSolver::LoS_OK_horizontal( const Vec2& p0_, const Vec2& p1_ )
     p += f; 
     while ( x < dx )
     {
-        fu_blocked = ( p.x == Nx || p.y == Ny || ! occupancy[ p.y * Nx + p.x ] );
-        fd_blocked = ( p.x == Nx || p.y == 0  || ! occupancy[ ( p.y - 1 ) * Nx + p.x ] );
+        fu_blocked = ( p.x == Nx || p.y == Ny || ! traversable( p.x, p.y ) );
+        fd_blocked = ( p.x == Nx || p.y == 0  || ! traversable( p.x, p.y - 1 ) );
         
         if ( ( fu_blocked && fd_blocked ) || ( fu_blocked && bd_blocked ) || ( bu_blocked && fd_blocked ) )
             return false; 
@@ -1411,8 +1440,8 @@ bool GapSolver::LoS_OK_vertical( const Vec2& p0_, const Vec2& p1_ )
 
     Vec2 p = _p0; 
 
-    bool bu_blocked = ( p.x == 0  || ! occupancy[ p.y * Nx + ( p.x - 1 ) ] ); 
-    bool fu_blocked = ( p.x == Nx || ! occupancy[ p.y * Nx + p.x ] ); 
+    bool bu_blocked = ( p.x == 0  || ! traversable( p.x - 1, p.y ) ); 
+    bool fu_blocked = ( p.x == Nx || ! traversable( p.x, p.y ) ); 
     if ( bu_blocked && fu_blocked )
         return false; 
 
@@ -1423,8 +1452,8 @@ bool GapSolver::LoS_OK_vertical( const Vec2& p0_, const Vec2& p1_ )
     p += u; 
     while ( y < dy )
     { 
-        bu_blocked = ( p.x == 0  || ! occupancy[ p.y * Nx + ( p.x - 1 ) ] ); 
-        fu_blocked = ( p.x == Nx || ! occupancy[ p.y * Nx + p.x ] );
+        bu_blocked = ( p.x == 0  || ! traversable( p.x - 1, p.y ) ); 
+        fu_blocked = ( p.x == Nx || ! traversable( p.x, p.y ) );
         if ( ( bu_blocked && fu_blocked ) || ( bu_blocked && fd_blocked ) || ( bd_blocked && fu_blocked ) )
             return false; 
 
@@ -1440,10 +1469,10 @@ bool GapSolver::LoS_OK_vertical( const Vec2& p0_, const Vec2& p1_ )
 
 bool GapSolver::cornering_OK( const Vec2& p0_, const Vec2& p1_, const Vec2& p2_ )
 {
-    int n_occupied_cells = ( ! occupancy[ p1_.y * Nx + p1_.x ] ) ? 1 : 0;  
-    n_occupied_cells += ( ! occupancy[ ( p1_.y - 1 ) * Nx + p1_.x ] ) ? 1 : 0;
-    n_occupied_cells += ( ! occupancy[ ( p1_.y - 1 ) * Nx + ( p1_.x - 1 ) ] ) ? 1 : 0;
-    n_occupied_cells += ( ! occupancy[ p1_.y * Nx + ( p1_.x - 1 ) ] ) ? 1 : 0;
+    int n_occupied_cells = ( ! traversable( p1_.x, p1_.y ) ) ? 1 : 0;  
+    n_occupied_cells += ( ! traversable( p1_.x, p1_.y - 1 ) ) ? 1 : 0;
+    n_occupied_cells += ( ! traversable( p1_.x - 1, p1_.y - 1 ) ) ? 1 : 0;
+    n_occupied_cells += ( ! traversable( p1_.x - 1, p1_.y ) ) ? 1 : 0;
 
     if ( n_occupied_cells != 1 )
         return false; 
@@ -1458,7 +1487,7 @@ bool GapSolver::start_goal_gppc_valid( const Vec2& pos_ )
     if ( pos_.x >= Nx || pos_.x < 0 || pos_.y >= Ny || pos_.y < 0 )
         return false;  
 
-    if ( ! occupancy[ pos_.y * Nx + pos_.y ] )
+    if ( ! traversable( pos_.y, pos_.y ) )
         return false;         
 
     return true; 
@@ -15,12 +15,14 @@
 std::string datafile, mapfile, scenfile, flag;
 const std::string index_dir = "index_data";
 std::vector<bool> mapData;
+GPPC::PackedGrid packedMap;
 int width, height;
 bool pre   = false;
 bool run   = false;
 bool check = false;
 
-void LoadMap(const char *fname, std::vector<bool> &map, int &width, int &height)
+// packed, when not nullptr, receives the map as well (see GPPC::BitGrid)
+void LoadMap(const char *fname, std::vector<bool> &map, int &width, int &height, GPPC::PackedGrid *packed = nullptr)
 {
   FILE *f;
   f = std::fopen(fname, "r");
@@ -28,6 +30,7 @@ void LoadMap(const char *fname, std::vector<bool> &map, int &width, int &height)
   {
     std::fscanf(f, "type octile\nheight %d\nwidth %d\nmap\n", &height, &width);
     map.resize(height*width);
+    if (packed) packed->Resize(width, height);
     for (int y = 0; y < height; y++)
     {
       for (int x = 0; x < width; x++)
@@ -37,9 +40,11 @@ void LoadMap(const char *fname, std::vector<bool> &map, int &width, int &height)
           std::fscanf(f, "%c", &c);
         } while (std::isspace(c));
         map[y*width+x] = (c == '.' || c == 'G' || c == 'S');
+        if (packed && map[y*width+x]) packed->Set(x, y);
       }
     }
     std::fclose(f);
+    if (packed) packed->Transpose();
   }
 }
 
@@ -186,17 +191,25 @@ int main(int argc, char **argv)
     std::exit(1);
   }
 
+  void (*preprocessBits)(const GPPC::BitGrid&, const std::string&) = PreprocessMap;
+  void *(*prepareBits)(const GPPC::BitGrid&, const std::string&) = PrepareForSearch;
+
   // in mapData, 1: traversable, 0: obstacle
-  LoadMap(mapfile.c_str(), mapData, width, height);
+  LoadMap(mapfile.c_str(), mapData, width, height, preprocessBits || prepareBits ? &packedMap : nullptr);
   datafile = index_dir + "/" + GetName() + "-" + basename(mapfile);
 
-  if (pre)
-    PreprocessMap(mapData, width, height, datafile);
+  if (pre) {
+    if (preprocessBits)
+      preprocessBits(packedMap.Grid(), datafile);
+    else
+      PreprocessMap(mapData, width, height, datafile);
+  }
   
   if (!run)
     return 0;
 
-  void *reference = PrepareForSearch(mapData, width, height, datafile);
+  void *reference = prepareBits ? prepareBits(packedMap.Grid(), datafile)
+                                : PrepareForSearch(mapData, width, height, datafile);
 
   char argument[256];
   std::sprintf(argument, "pmap -x %d | tail -n 1 > run.info", getpid());
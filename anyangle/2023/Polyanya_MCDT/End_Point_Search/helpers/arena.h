@@ -0,0 +1,109 @@
+#pragma once
+
+// arena.h
+//
+// A bump allocator for objects that all die together, such as the nodes
+// of one search. Objects are carved from large chunks in order and never
+// freed one at a time; reset() makes every chunk available again in
+// constant time. Chunks are kept from one reset to the next, so once the
+// arena has grown to fit the largest search it no longer allocates.
+//
+// Unlike warthog::mem::cpool there is no free list, and reclaiming does
+// not touch each chunk.
+//
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace warthog
+{
+
+namespace mem
+{
+
+class arena
+{
+    public:
+        arena(size_t obj_size, size_t chunk_size = 1024*256) :
+            obj_size_(round_up(obj_size)),
+            chunk_size_(chunk_size < obj_size_ ? obj_size_ :
+                        chunk_size - (chunk_size % obj_size_)),
+            current_(0), next_(nullptr), max_(nullptr)
+        {
+            add_chunk();
+        }
+
+        ~arena()
+        {
+            for(char* c : chunks_)
+            {
+                delete [] c;
+            }
+        }
+
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        // forget everything allocated so far
+        inline void
+        reset()
+        {
+            current_ = 0;
+            next_ = chunks_[0];
+            max_ = next_ + chunk_size_;
+        }
+
+        inline char*
+        allocate()
+        {
+            if(next_ == max_)
+            {
+                if(++current_ == chunks_.size())
+                {
+                    add_chunk();
+                }
+                next_ = chunks_[current_];
+                max_ = next_ + chunk_size_;
+            }
+            char* retval = next_;
+            next_ += obj_size_;
+            return retval;
+        }
+
+        size_t
+        mem()
+        {
+            return sizeof(*this) + chunks_.size()*chunk_size_ +
+                   chunks_.capacity()*sizeof(char*);
+        }
+
+    private:
+        // keep every object aligned as new would
+        static size_t
+        round_up(size_t size)
+        {
+            const size_t align = alignof(std::max_align_t);
+            return size == 0 ? align : (size + align - 1) / align * align;
+        }
+
+        void
+        add_chunk()
+        {
+            chunks_.push_back(new char[chunk_size_]);
+            current_ = chunks_.size() - 1;
+            next_ = chunks_.back();
+            max_ = next_ + chunk_size_;
+        }
+
+        size_t obj_size_;
+        size_t chunk_size_;
+        std::vector<char*> chunks_;
+        size_t current_;
+        char* next_;
+        char* max_;
+};
+
+}
+
+}
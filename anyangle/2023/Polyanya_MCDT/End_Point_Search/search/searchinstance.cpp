@@ -80,6 +80,7 @@ namespace polyanya {
                         // First time reaching root
                         root_search_ids[root] = search_id;
                         root_g_values[root] = g;
+                        root_nodes[root] = nullptr;
                     }
                     else
                     {
@@ -139,6 +140,45 @@ namespace polyanya {
         return out;
     }
 
+    // Nodes with the same root and interval have the same successors and
+    // h, and differ only by g, so only the best one needs to be open. An
+    // equal node can only be open if its root has been reached twice,
+    // which is rare; only then do we look through the nodes of the root.
+    bool SearchInstance::push(SearchNodePtr node)
+    {
+        const int root = node->root;
+        if (root != -1)
+        {
+            for (SearchNodePtr other = root_nodes[root]; other != nullptr;
+                 other = other->same_root)
+            {
+                // exactly the same interval; Point::operator== has slack
+                if (!open_list.contains(other) ||
+                    other->next_polygon != node->next_polygon ||
+                    other->left.x != node->left.x ||
+                    other->left.y != node->left.y ||
+                    other->right.x != node->right.x ||
+                    other->right.y != node->right.y)
+                {
+                    continue;
+                }
+                if (other->g <= node->g)
+                {
+                    return false;
+                }
+                // same h, so this is a decrease-key
+                open_list.replace(other, node);
+                node->same_root = root_nodes[root];
+                root_nodes[root] = node;
+                return true;
+            }
+            node->same_root = root_nodes[root];
+            root_nodes[root] = node;
+        }
+        open_list.push(node);
+        return true;
+    }
+
     void SearchInstance::set_end_polygon()
     {
         // Any polygon is fine.
@@ -182,7 +222,9 @@ namespace polyanya {
             // iterate over poly, throwing away vertices if needed
             const std::vector<int>& vertices =
                     mesh->mesh_polygons[poly].vertices;
-            Successor* successors = new Successor [vertices.size()];
+            // nothing has been pushed yet, so the buffers for search()
+            // are free
+            Successor* successors = search_successors;
             int last_vertex = vertices.back();
             int num_succ = 0;
             for (int i = 0; i < (int) vertices.size(); i++)
@@ -199,10 +241,9 @@ namespace polyanya {
                          v(last_vertex).p, i};
                 last_vertex = vertex;
             }
-            SearchNode* nodes = new SearchNode [num_succ];
+            SearchNode* nodes = search_nodes_to_push;
             const int num_nodes = succ_to_node(lazy, successors,
                                                num_succ, nodes);
-            delete[] successors;
             for (int i = 0; i < num_nodes; i++)
             {
                 SearchNodePtr n = new (node_pool->allocate())
@@ -219,11 +260,9 @@ namespace polyanya {
                     std::cerr << std::endl;
                 }
 #endif
-                open_list.push(n);
+                nodes_pushed += push(n);
             }
-            delete[] nodes;
             nodes_generated += num_nodes;
-            nodes_pushed += num_nodes;
         };
 
         switch (pl.type)
@@ -311,7 +350,7 @@ namespace polyanya {
 
         while (!open_list.empty())
         {
-            SearchNodePtr node = open_list.top(); open_list.pop();
+            SearchNodePtr node = open_list.pop();
 
 #ifndef NDEBUG
             if (verbose)
@@ -460,10 +499,9 @@ namespace polyanya {
                 }
 #endif
 
-                open_list.push(n);
+                nodes_pushed += push(n);
             }
             nodes_generated += num_nodes;
-            nodes_pushed += num_nodes;
         }
 
         return false;
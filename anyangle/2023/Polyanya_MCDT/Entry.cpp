@@ -334,6 +334,9 @@ void PreprocessMap(const std::vector<bool> &bits, int width, int height, const s
     cdtutils::convertPoly2Mesh(filename+".poly",filename+".mesh",width);
     mesh2merged::convertMesh2MergedMesh(filename+".mesh",filename+".merged-mesh");
 
+    ifstream meshfile(filename+".merged-mesh");
+    pl::Mesh mesh(meshfile);
+    mesh.save_binary(filename+".mesh-bin");
 
 ////        convertgrid2rect(bits, width, height,filename+".merged-mesh");
 //    build_visiblity_graph(filename+".merged-mesh", filename+".vis",bits, width, height);
@@ -361,9 +364,14 @@ void PreprocessMap(const std::vector<bool> &bits, int width, int height, const s
  * @returns Pointer to data-structure used for search.  Memory should be stored on heap, not stack.
  */
 void *PrepareForSearch(const vector<bool> &bits, int width, int height, const string &filename) {
-    string mesh_path = filename+".merged-mesh";
-    ifstream meshfile(mesh_path);
-    mp = new pl::Mesh(meshfile);
+    mp = new pl::Mesh();
+    if (!mp->load_binary(filename+".mesh-bin")) {
+        // preprocessed before binary meshes existed
+        delete mp;
+        string mesh_path = filename+".merged-mesh";
+        ifstream meshfile(mesh_path);
+        mp = new pl::Mesh(meshfile);
+    }
     pl::SearchInstance* si  = new pl::SearchInstance(mp);
     return si;
 }
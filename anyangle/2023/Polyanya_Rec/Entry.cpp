@@ -26,13 +26,22 @@ void PreprocessMap(const std::vector<bool> &bits, int width, int height, const s
 //    mesh2merged::convertMesh2MergedMesh(filename+".mesh",filename+".merged-mesh");
 //    mesh2merged::convertMesh2MergedMesh(filename+".mesh",filename+".merged-mesh");
     convertgrid2rect(bits, width, height,filename+".merged-mesh");
+
+    ifstream meshfile(filename+".merged-mesh");
+    pl::Mesh mesh(meshfile);
+    mesh.save_binary(filename+".mesh-bin");
 }
 
 void *PrepareForSearch(const std::vector<bool> &bits, int width, int height, const std::string &filename) {
 
-    string mesh_path = filename+".merged-mesh";
-    ifstream meshfile(mesh_path);
-    mp = new pl::Mesh(meshfile);
+    mp = new pl::Mesh();
+    if (!mp->load_binary(filename+".mesh-bin")) {
+        // preprocessed before binary meshes existed
+        delete mp;
+        string mesh_path = filename+".merged-mesh";
+        ifstream meshfile(mesh_path);
+        mp = new pl::Mesh(meshfile);
+    }
     pl::SearchInstance* si  = new pl::SearchInstance(mp);
     return si;
 }
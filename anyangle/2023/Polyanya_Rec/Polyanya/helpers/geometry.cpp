@@ -4,9 +4,54 @@
 #include <cmath>
 #include <cassert>
 
+#if !defined(POLYANYA_NO_SIMD) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define POLYANYA_AVX_CROSS
+#include <immintrin.h>
+#endif
+
 namespace polyanya
 {
 
+#ifdef POLYANYA_AVX_CROSS
+// Only multiplies and subtracts, in the same order as Point's operators.
+// The target has no FMA, so nothing can be contracted and every lane is
+// rounded as the scalar code would be.
+__attribute__((target("avx")))
+static int cross_batch_avx(const double* xs, const double* ys, int n,
+                           const Point& o, const Point& d, double* out)
+{
+    const __m256d ox = _mm256_set1_pd(o.x), oy = _mm256_set1_pd(o.y);
+    const __m256d dx = _mm256_set1_pd(d.x), dy = _mm256_set1_pd(d.y);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m256d vx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), ox);
+        const __m256d vy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), oy);
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_mul_pd(dx, vy),
+                                                _mm256_mul_pd(dy, vx)));
+    }
+    return i;
+}
+#endif
+
+void cross_batch(const double* xs, const double* ys, int n,
+                 const Point& o, const Point& d, double* out)
+{
+    int i = 0;
+#ifdef POLYANYA_AVX_CROSS
+    static const bool has_avx = __builtin_cpu_supports("avx");
+    if (has_avx)
+    {
+        i = cross_batch_avx(xs, ys, n, o, d, out);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        out[i] = d * (Point{xs[i], ys[i]} - o);
+    }
+}
+
 // Given two line segments ab and cd defined as:
 //   ab(t) = a + (b-a) * t
 //   cd(t) = c + (d-c) * t
@@ -0,0 +1,137 @@
+#pragma once
+#include "searchnode.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace polyanya
+{
+
+// The open list of a SearchInstance: a 4-ary min-heap of search nodes,
+// ordered as SearchNode::operator<. Each node knows its position in the
+// heap (SearchNode::heap_index, -1 once popped), so an open node can be
+// replaced in place by a better one.
+//
+// Nodes are not owned. The heap keeps its storage between searches and
+// clear() takes constant time, so a queue should live as long as its
+// instance.
+class NodeQueue
+{
+public:
+    NodeQueue() : heap_size(0)
+    {
+        heap.resize(1024);
+    }
+
+    bool empty() const { return heap_size == 0; }
+    size_t size() const { return heap_size; }
+    void clear() { heap_size = 0; }
+
+    static bool contains(const SearchNode* node)
+    {
+        return node->heap_index >= 0;
+    }
+
+    SearchNodePtr top() const
+    {
+        assert(!empty());
+        return heap[0];
+    }
+
+    SearchNodePtr pop()
+    {
+        assert(!empty());
+        SearchNodePtr ret = heap[0];
+        ret->heap_index = -1;
+        if (--heap_size > 0)
+        {
+            heap[0] = heap[heap_size];
+            move_down(0);
+        }
+        return ret;
+    }
+
+    void push(SearchNodePtr node)
+    {
+        if (heap_size == heap.size())
+        {
+            heap.resize(2 * heap.size());
+        }
+        heap[heap_size] = node;
+        move_up(heap_size++);
+    }
+
+    // Put @param node where the open node @param old is. Meant for a
+    // node that is no bigger; it may be bigger by rounding only.
+    void replace(SearchNodePtr old, SearchNodePtr node)
+    {
+        assert(contains(old));
+        const size_t pos = old->heap_index;
+        old->heap_index = -1;
+        heap[pos] = node;
+        move_up(pos);
+        move_down(node->heap_index);
+    }
+
+private:
+    static const size_t arity = 4;
+
+    std::vector<SearchNodePtr> heap;
+    size_t heap_size;
+
+    static bool less(const SearchNode* a, const SearchNode* b)
+    {
+        return *a < *b;
+    }
+
+    void move_up(size_t pos)
+    {
+        SearchNodePtr node = heap[pos];
+        while (pos != 0)
+        {
+            const size_t parent = (pos - 1) / arity;
+            if (!less(node, heap[parent]))
+            {
+                break;
+            }
+            heap[pos] = heap[parent];
+            heap[pos]->heap_index = (int) pos;
+            pos = parent;
+        }
+        heap[pos] = node;
+        node->heap_index = (int) pos;
+    }
+
+    void move_down(size_t pos)
+    {
+        SearchNodePtr node = heap[pos];
+        for (;;)
+        {
+            const size_t first = arity * pos + 1;
+            if (first >= heap_size)
+            {
+                break;
+            }
+            const size_t last = std::min(first + arity, heap_size);
+            size_t best = first;
+            for (size_t c = first + 1; c < last; c++)
+            {
+                if (less(heap[c], heap[best]))
+                {
+                    best = c;
+                }
+            }
+            if (!less(heap[best], node))
+            {
+                break;
+            }
+            heap[pos] = heap[best];
+            heap[pos]->heap_index = (int) pos;
+            pos = best;
+        }
+        heap[pos] = node;
+        node->heap_index = (int) pos;
+    }
+};
+
+}
@@ -12,6 +12,13 @@
 #include "graph.h"
 #include <fstream>
 #include <sstream>
+#include <tuple>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace polyanya
 {
@@ -21,9 +28,19 @@ Mesh::Mesh(std::istream& infile)
 {
     read(infile);
     precalc_point_location();
+    precalc_grid_point_location();
+    precalc_polygon_points();
     Initialize_edge();
 }
 
+Mesh::~Mesh()
+{
+    if (mapping != nullptr)
+    {
+        munmap(mapping, mapping_size);
+    }
+}
+
 void Mesh::read(std::istream& infile)
 {
     #define fail(message) std::cerr << message << std::endl; exit(1);
@@ -229,6 +246,406 @@ void Mesh::read(std::istream& infile)
     #undef fail
 }
 
+// Binary mesh files (native byte order, BINARY_VERSION):
+//   [0, 4096)    MeshFileHeader, zero padded to one page
+//   [4096, ...)  the sections below, in order, each at a multiple of 8
+//                bytes. counts are in elements; lists use CSR offsets
+//                (count + 1 of them) followed by the data.
+//
+//   VERTEX_POINTS        double x, y per vertex
+//   VERTEX_FLAGS         is_corner | is_ambig << 1 | is_turning_vertex << 2
+//   VERTEX_POLYGON_BEGIN, VERTEX_POLYGONS
+//   VERTEX_OBSTACLE_BEGIN, VERTEX_OBSTACLES   (Vertex::obstacle_edge)
+//   POLYGON_BEGIN        shared by the three polygon lists below
+//   POLYGON_VERTICES, POLYGON_POLYGONS, POLYGON_EDGES
+//   POLYGON_BOUNDS       double min_x, max_x, min_y, max_y per polygon
+//   POLYGON_ONE_WAY
+//   MESH_EDGES, OBSTACLE_EDGES   int vertex1, vertex2, poly1, poly2
+//   SLAB_X (double), SLAB_BEGIN, SLAB_POLYGONS
+//   GRID_LOCATIONS       PointLocation as five ints
+//   GRID_STORAGE         the grid point location tables, used in place
+//
+// Files are written by the preprocessing of the same build that reads
+// them, so only their structure is checked on loading.
+namespace
+{
+    enum MeshFileSection
+    {
+        VERTEX_POINTS, VERTEX_FLAGS, VERTEX_POLYGON_BEGIN, VERTEX_POLYGONS,
+        VERTEX_OBSTACLE_BEGIN, VERTEX_OBSTACLES, POLYGON_BEGIN,
+        POLYGON_VERTICES, POLYGON_POLYGONS, POLYGON_EDGES, POLYGON_BOUNDS,
+        POLYGON_ONE_WAY, MESH_EDGES, OBSTACLE_EDGES, SLAB_X, SLAB_BEGIN,
+        SLAB_POLYGONS, GRID_LOCATIONS, GRID_STORAGE, NUM_SECTIONS
+    };
+
+    const char MESH_FILE_MAGIC[8] = {'P', 'L', 'Y', 'M', 'E', 'S', 'H', 0};
+    const size_t MESH_FILE_DATA_OFFSET = 4096;
+
+    struct MeshFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t num_sections;
+        uint64_t file_size;
+        int32_t num_vertices, num_polygons, max_poly_sides, width, height;
+        int32_t grid_cols, grid_rows;
+        double min_x, max_x, min_y, max_y;
+        struct
+        {
+            uint64_t offset, count;
+        } sections[NUM_SECTIONS];
+    };
+    static_assert(sizeof(MeshFileHeader) <= MESH_FILE_DATA_OFFSET,
+                  "mesh file header must fit in the first page");
+
+    struct MeshFileSectionData
+    {
+        const void* data;
+        uint64_t count;
+        size_t elem_size;
+    };
+
+    // The list starting at offsets[i] of a CSR section.
+    std::vector<int> csr_list(const int32_t* offsets, const int32_t* data,
+                              int i)
+    {
+        return std::vector<int>(data + offsets[i], data + offsets[i + 1]);
+    }
+
+    bool csr_valid(const int32_t* offsets, uint64_t n, uint64_t data_count)
+    {
+        if (offsets[0] != 0 || (uint64_t) offsets[n] != data_count)
+        {
+            return false;
+        }
+        for (uint64_t i = 0; i < n; i++)
+        {
+            if (offsets[i] > offsets[i + 1])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool Mesh::save_binary(const std::string& filename) const
+{
+    const int V = mesh_vertices.size(), P = mesh_polygons.size();
+
+    std::vector<double> points, bounds, slab_x;
+    std::vector<int32_t> flags, vertex_polygon_begin(1, 0), vertex_polygons,
+        vertex_obstacle_begin(1, 0), vertex_obstacles, polygon_begin(1, 0),
+        polygon_vertices, polygon_polygons, polygon_edges, one_way,
+        edges, obstacles, slab_begin(1, 0), slab_polygons, locations;
+    for (const Vertex& v : mesh_vertices)
+    {
+        points.push_back(v.p.x);
+        points.push_back(v.p.y);
+        flags.push_back(v.is_corner | v.is_ambig << 1 |
+                        v.is_turning_vertex << 2);
+        vertex_polygons.insert(vertex_polygons.end(),
+                               v.polygons.begin(), v.polygons.end());
+        vertex_polygon_begin.push_back(vertex_polygons.size());
+        vertex_obstacles.insert(vertex_obstacles.end(),
+                                v.obstacle_edge.begin(), v.obstacle_edge.end());
+        vertex_obstacle_begin.push_back(vertex_obstacles.size());
+    }
+    for (const Polygon& poly : mesh_polygons)
+    {
+        if (poly.polygons.size() != poly.vertices.size() ||
+            poly.edges.size() != poly.vertices.size())
+        {
+            std::cerr << "cannot save mesh to " << filename
+                      << ": polygon edges are not initialised" << std::endl;
+            return false;
+        }
+        polygon_vertices.insert(polygon_vertices.end(),
+                                poly.vertices.begin(), poly.vertices.end());
+        polygon_polygons.insert(polygon_polygons.end(),
+                                poly.polygons.begin(), poly.polygons.end());
+        polygon_edges.insert(polygon_edges.end(),
+                             poly.edges.begin(), poly.edges.end());
+        polygon_begin.push_back(polygon_vertices.size());
+        bounds.insert(bounds.end(),
+                      {poly.min_x, poly.max_x, poly.min_y, poly.max_y});
+        one_way.push_back(poly.is_one_way);
+    }
+    for (const Edge& e : mesh_edges)
+    {
+        edges.insert(edges.end(), {e.vertices.first, e.vertices.second,
+                                   e.polygons.first, e.polygons.second});
+    }
+    for (const Edge& e : obstacle_edges)
+    {
+        obstacles.insert(obstacles.end(), {e.vertices.first, e.vertices.second,
+                                           e.polygons.first, e.polygons.second});
+    }
+    for (const auto& slab : slabs)
+    {
+        slab_x.push_back(slab.first);
+        slab_polygons.insert(slab_polygons.end(),
+                             slab.second.begin(), slab.second.end());
+        slab_begin.push_back(slab_polygons.size());
+    }
+    for (const PointLocation& pl : grid_locations)
+    {
+        locations.insert(locations.end(), {(int) pl.type, pl.poly1, pl.poly2,
+                                           pl.vertex1, pl.vertex2});
+    }
+    const size_t grid_size = grid_vertex_locations == nullptr ? 0 :
+        (size_t) (grid_cols + 1) * (grid_rows + 1) +
+        (size_t) grid_cols * grid_rows;
+
+    const MeshFileSectionData sections[NUM_SECTIONS] = {
+        {points.data(), points.size(), sizeof(double)},
+        {flags.data(), flags.size(), sizeof(int32_t)},
+        {vertex_polygon_begin.data(), vertex_polygon_begin.size(),
+         sizeof(int32_t)},
+        {vertex_polygons.data(), vertex_polygons.size(), sizeof(int32_t)},
+        {vertex_obstacle_begin.data(), vertex_obstacle_begin.size(),
+         sizeof(int32_t)},
+        {vertex_obstacles.data(), vertex_obstacles.size(), sizeof(int32_t)},
+        {polygon_begin.data(), polygon_begin.size(), sizeof(int32_t)},
+        {polygon_vertices.data(), polygon_vertices.size(), sizeof(int32_t)},
+        {polygon_polygons.data(), polygon_polygons.size(), sizeof(int32_t)},
+        {polygon_edges.data(), polygon_edges.size(), sizeof(int32_t)},
+        {bounds.data(), bounds.size(), sizeof(double)},
+        {one_way.data(), one_way.size(), sizeof(int32_t)},
+        {edges.data(), edges.size(), sizeof(int32_t)},
+        {obstacles.data(), obstacles.size(), sizeof(int32_t)},
+        {slab_x.data(), slab_x.size(), sizeof(double)},
+        {slab_begin.data(), slab_begin.size(), sizeof(int32_t)},
+        {slab_polygons.data(), slab_polygons.size(), sizeof(int32_t)},
+        {locations.data(), locations.size(), sizeof(int32_t)},
+        {grid_vertex_locations, grid_size, sizeof(int32_t)},
+    };
+
+    MeshFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, MESH_FILE_MAGIC, sizeof(h.magic));
+    h.version = BINARY_VERSION;
+    h.num_sections = NUM_SECTIONS;
+    h.num_vertices = V;
+    h.num_polygons = P;
+    h.max_poly_sides = max_poly_sides;
+    h.width = width;
+    h.height = height;
+    h.grid_cols = grid_cols;
+    h.grid_rows = grid_rows;
+    h.min_x = min_x;
+    h.max_x = max_x;
+    h.min_y = min_y;
+    h.max_y = max_y;
+    uint64_t offset = MESH_FILE_DATA_OFFSET;
+    for (int i = 0; i < NUM_SECTIONS; i++)
+    {
+        h.sections[i].offset = offset;
+        h.sections[i].count = sections[i].count;
+        offset += (sections[i].count * sections[i].elem_size + 7) & ~7ULL;
+    }
+    h.file_size = offset;
+
+    // Write next to the target and rename, so that a reader never maps a
+    // partly written file.
+    const std::string tmpname = filename + ".tmp";
+    FILE* f = fopen(tmpname.c_str(), "wb");
+    if (f == NULL)
+    {
+        std::cerr << "cannot write mesh to " << tmpname << std::endl;
+        return false;
+    }
+    static const char zeros[MESH_FILE_DATA_OFFSET] = {0};
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+        fwrite(zeros, 1, MESH_FILE_DATA_OFFSET - sizeof(h), f) ==
+            MESH_FILE_DATA_OFFSET - sizeof(h);
+    for (int i = 0; i < NUM_SECTIONS && ok; i++)
+    {
+        const size_t bytes = sections[i].count * sections[i].elem_size;
+        ok = (bytes == 0 || fwrite(sections[i].data, 1, bytes, f) == bytes) &&
+            fwrite(zeros, 1, -bytes & 7, f) == (-bytes & 7);
+    }
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || rename(tmpname.c_str(), filename.c_str()) != 0)
+    {
+        std::cerr << "failed writing mesh to " << filename << std::endl;
+        remove(tmpname.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Mesh::load_binary(const std::string& filename)
+{
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < MESH_FILE_DATA_OFFSET)
+    {
+        close(fd);
+        return false;
+    }
+    const size_t size = st.st_size;
+    void* mem = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED)
+    {
+        return false;
+    }
+    const char* base = static_cast<const char*>(mem);
+    const MeshFileHeader& h = *reinterpret_cast<const MeshFileHeader*>(base);
+
+    const size_t elem_sizes[NUM_SECTIONS] = {
+        sizeof(double), 4, 4, 4, 4, 4, 4, 4, 4, 4, sizeof(double), 4, 4, 4,
+        sizeof(double), 4, 4, 4, 4
+    };
+    bool ok = memcmp(h.magic, MESH_FILE_MAGIC, sizeof(h.magic)) == 0 &&
+        h.version == BINARY_VERSION && h.num_sections == NUM_SECTIONS &&
+        h.file_size == size && h.num_vertices >= 0 && h.num_polygons >= 0 &&
+        h.grid_cols >= 0 && h.grid_rows >= 0;
+    for (int i = 0; i < NUM_SECTIONS && ok; i++)
+    {
+        ok = h.sections[i].offset % 8 == 0 &&
+            h.sections[i].offset >= MESH_FILE_DATA_OFFSET &&
+            h.sections[i].count <= size / elem_sizes[i] &&
+            h.sections[i].offset + h.sections[i].count * elem_sizes[i] <= size;
+    }
+    const auto section = [&](int i)
+    {
+        return reinterpret_cast<const int32_t*>(base + h.sections[i].offset);
+    };
+    const auto count = [&](int i) { return h.sections[i].count; };
+    const uint64_t V = h.num_vertices, P = h.num_polygons;
+    const uint64_t grid_points = (uint64_t) (h.grid_cols + 1) *
+        (h.grid_rows + 1);
+    const uint64_t grid_cells = (uint64_t) h.grid_cols * h.grid_rows;
+    ok = ok &&
+        count(VERTEX_POINTS) == 2 * V && count(VERTEX_FLAGS) == V &&
+        count(VERTEX_POLYGON_BEGIN) == V + 1 &&
+        count(VERTEX_OBSTACLE_BEGIN) == V + 1 &&
+        count(POLYGON_BEGIN) == P + 1 &&
+        count(POLYGON_POLYGONS) == count(POLYGON_VERTICES) &&
+        count(POLYGON_EDGES) == count(POLYGON_VERTICES) &&
+        count(POLYGON_BOUNDS) == 4 * P && count(POLYGON_ONE_WAY) == P &&
+        count(MESH_EDGES) % 4 == 0 && count(OBSTACLE_EDGES) % 4 == 0 &&
+        count(SLAB_BEGIN) == count(SLAB_X) + 1 &&
+        count(GRID_LOCATIONS) % 5 == 0 &&
+        (count(GRID_STORAGE) == 0 ||
+         count(GRID_STORAGE) == grid_points + grid_cells) &&
+        csr_valid(section(VERTEX_POLYGON_BEGIN), V, count(VERTEX_POLYGONS)) &&
+        csr_valid(section(VERTEX_OBSTACLE_BEGIN), V,
+                  count(VERTEX_OBSTACLES)) &&
+        csr_valid(section(POLYGON_BEGIN), P, count(POLYGON_VERTICES)) &&
+        csr_valid(section(SLAB_BEGIN), count(SLAB_X), count(SLAB_POLYGONS));
+    if (!ok)
+    {
+        std::cerr << filename << " is not a version " << BINARY_VERSION
+                  << " mesh file" << std::endl;
+        munmap(mem, size);
+        return false;
+    }
+
+    const double* points =
+        reinterpret_cast<const double*>(base + h.sections[VERTEX_POINTS].offset);
+    const int32_t* flags = section(VERTEX_FLAGS);
+    mesh_vertices.resize(V);
+    for (uint64_t i = 0; i < V; i++)
+    {
+        Vertex& v = mesh_vertices[i];
+        v.p = {points[2 * i], points[2 * i + 1]};
+        v.is_corner = flags[i] & 1;
+        v.is_ambig = flags[i] & 2;
+        v.is_turning_vertex = flags[i] & 4;
+        v.polygons = csr_list(section(VERTEX_POLYGON_BEGIN),
+                              section(VERTEX_POLYGONS), i);
+        v.obstacle_edge = csr_list(section(VERTEX_OBSTACLE_BEGIN),
+                                   section(VERTEX_OBSTACLES), i);
+    }
+
+    const double* bounds =
+        reinterpret_cast<const double*>(base + h.sections[POLYGON_BOUNDS].offset);
+    const int32_t* one_way = section(POLYGON_ONE_WAY);
+    mesh_polygons.resize(P);
+    for (uint64_t i = 0; i < P; i++)
+    {
+        Polygon& poly = mesh_polygons[i];
+        poly.vertices = csr_list(section(POLYGON_BEGIN),
+                                 section(POLYGON_VERTICES), i);
+        poly.polygons = csr_list(section(POLYGON_BEGIN),
+                                 section(POLYGON_POLYGONS), i);
+        poly.edges = csr_list(section(POLYGON_BEGIN),
+                              section(POLYGON_EDGES), i);
+        poly.min_x = bounds[4 * i];
+        poly.max_x = bounds[4 * i + 1];
+        poly.min_y = bounds[4 * i + 2];
+        poly.max_y = bounds[4 * i + 3];
+        poly.is_one_way = one_way[i];
+    }
+
+    const auto read_edges = [&](int i, std::vector<Edge>& out)
+    {
+        const int32_t* e = section(i);
+        out.resize(count(i) / 4);
+        for (Edge& edge : out)
+        {
+            edge.vertices = std::make_pair(e[0], e[1]);
+            edge.polygons = std::make_pair(e[2], e[3]);
+            e += 4;
+        }
+    };
+    read_edges(MESH_EDGES, mesh_edges);
+    read_edges(OBSTACLE_EDGES, obstacle_edges);
+
+    const double* slab_x =
+        reinterpret_cast<const double*>(base + h.sections[SLAB_X].offset);
+    slabs.clear();
+    for (uint64_t i = 0; i < count(SLAB_X); i++)
+    {
+        slabs.emplace_hint(slabs.end(), slab_x[i],
+                           csr_list(section(SLAB_BEGIN),
+                                    section(SLAB_POLYGONS), i));
+    }
+
+    const int32_t* locations = section(GRID_LOCATIONS);
+    grid_locations.resize(count(GRID_LOCATIONS) / 5);
+    for (PointLocation& pl : grid_locations)
+    {
+        pl = {(PointLocation::Type) locations[0], locations[1], locations[2],
+              locations[3], locations[4]};
+        locations += 5;
+    }
+    grid_cols = h.grid_cols;
+    grid_rows = h.grid_rows;
+    grid_storage.clear();
+    grid_vertex_locations = grid_cell_polygons = nullptr;
+    if (count(GRID_STORAGE) != 0)
+    {
+        grid_vertex_locations = section(GRID_STORAGE);
+        grid_cell_polygons = grid_vertex_locations + grid_points;
+    }
+
+    max_poly_sides = h.max_poly_sides;
+    width = h.width;
+    height = h.height;
+    min_x = h.min_x;
+    max_x = h.max_x;
+    min_y = h.min_y;
+    max_y = h.max_y;
+
+    precalc_polygon_points();
+
+    if (mapping != nullptr)
+    {
+        munmap(mapping, mapping_size);
+    }
+    mapping = mem;
+    mapping_size = size;
+    return true;
+}
+
 void Mesh::precalc_point_location()
 {
     for (Vertex& v : mesh_vertices)
@@ -264,6 +681,175 @@ void Mesh::precalc_point_location()
     }
 }
 
+void Mesh::precalc_polygon_points()
+{
+    polygon_points.resize(mesh_polygons.size());
+    polygon_coords.clear();
+    for (int i = 0; i < (int) mesh_polygons.size(); i++)
+    {
+        polygon_points[i] = (int) polygon_coords.size();
+        for (int v : mesh_polygons[i].vertices)
+        {
+            polygon_coords.push_back(mesh_vertices[v].p.x);
+        }
+        for (int v : mesh_polygons[i].vertices)
+        {
+            polygon_coords.push_back(mesh_vertices[v].p.y);
+        }
+    }
+}
+
+void Mesh::precalc_grid_point_location()
+{
+    grid_cols = grid_rows = 0;
+    grid_locations.clear();
+    grid_storage.clear();
+    grid_vertex_locations = grid_cell_polygons = nullptr;
+    for (const Vertex& v : mesh_vertices)
+    {
+        if (v.p.x != std::floor(v.p.x) || v.p.y != std::floor(v.p.y))
+        {
+            return;
+        }
+    }
+    grid_cols = (int) (max_x - min_x);
+    grid_rows = (int) (max_y - min_y);
+    const size_t num_points = (size_t) (grid_cols + 1) * (grid_rows + 1);
+    grid_storage.assign(num_points + (size_t) grid_cols * grid_rows, -1);
+    int* const point_ids = grid_storage.data();
+    int* const cell_polys = point_ids + num_points;
+
+    // Scan each polygon a lattice row at a time. As polygons are convex
+    // and their vertices are on the lattice, the row between lines y and
+    // y + 1 spans [min(l0, l1), max(r0, r1)], where [l, r] is the extent of
+    // the polygon on each line. Cells inside [max(l0, l1), min(r0, r1)]
+    // lie in the polygon; the others it touches are split. Free space is
+    // bounded by obstacle cells, so cells no polygon touches are off the
+    // mesh. Borders cross lattice lines at multiples of
+    // 1 / (max_y - min_y), far coarser than the tolerance used here.
+    static const double TOLERANCE = 1e-9;
+    for (int i = 0; i < (int) mesh_polygons.size(); i++)
+    {
+        const Polygon& poly = mesh_polygons[i];
+        const auto extent = [&](double y, double& l, double& r)
+        {
+            l = poly.max_x;
+            r = poly.min_x;
+            Point last = mesh_vertices[poly.vertices.back()].p;
+            for (int v : poly.vertices)
+            {
+                const Point& cur = mesh_vertices[v].p;
+                if (last.y == cur.y)
+                {
+                    if (cur.y == y)
+                    {
+                        l = std::min(l, std::min(last.x, cur.x));
+                        r = std::max(r, std::max(last.x, cur.x));
+                    }
+                }
+                else if (std::min(last.y, cur.y) <= y &&
+                         y <= std::max(last.y, cur.y))
+                {
+                    const double x = last.x + (y - last.y) *
+                        (cur.x - last.x) / (cur.y - last.y);
+                    l = std::min(l, x);
+                    r = std::max(r, x);
+                }
+                last = cur;
+            }
+        };
+
+        int inside = -1;
+        double l0, r0, l1, r1;
+        extent(poly.min_y, l1, r1);
+        for (int y = (int) (poly.min_y - min_y);
+             y < (int) (poly.max_y - min_y); y++)
+        {
+            l0 = l1;
+            r0 = r1;
+            extent(min_y + y + 1, l1, r1);
+
+            const double lo = std::min(l0, l1), hi = std::max(r0, r1);
+            const double whole_lo = std::max(l0, l1),
+                         whole_hi = std::min(r0, r1);
+            int* cells = &cell_polys[(size_t) y * grid_cols];
+            for (int x = (int) std::floor(lo + TOLERANCE - min_x);
+                 min_x + x < hi - TOLERANCE; x++)
+            {
+                const bool whole = min_x + x >= whole_lo - TOLERANCE &&
+                                   min_x + x + 1 <= whole_hi + TOLERANCE;
+                cells[x] = whole ? i : GRID_CELL_SPLIT;
+            }
+
+            // Lattice points inside the polygon on line y + 1.
+            if (min_y + y + 1 >= poly.max_y)
+            {
+                continue;
+            }
+            int* points = &point_ids[(size_t) (y + 1) * (grid_cols + 1)];
+            for (int x = (int) std::floor(l1 + TOLERANCE - min_x) + 1;
+                 min_x + x < r1 - TOLERANCE; x++)
+            {
+                if (inside == -1)
+                {
+                    inside = (int) grid_locations.size();
+                    grid_locations.push_back(
+                        {PointLocation::IN_POLYGON, i, -1, -1, -1});
+                }
+                points[x] = inside;
+            }
+        }
+    }
+
+    // Lattice points with only obstacle cells around them are off the
+    // mesh. The rest are on edges or vertices, and are located through the
+    // slabs exactly as before. Points on the same edge share a location, so
+    // each location is stored once.
+    std::map<std::tuple<int, int, int, int, int>, int> ids;
+    const auto location_id = [&](const PointLocation& pl) -> int
+    {
+        const auto it = ids.emplace(
+            std::make_tuple((int) pl.type, pl.poly1, pl.poly2,
+                            pl.vertex1, pl.vertex2),
+            (int) grid_locations.size());
+        if (it.second)
+        {
+            grid_locations.push_back(pl);
+        }
+        return it.first->second;
+    };
+    const int off_mesh_id =
+        location_id({PointLocation::NOT_ON_MESH, -1, -1, -1, -1});
+    for (int y = 0; y <= grid_rows; y++)
+    {
+        for (int x = 0; x <= grid_cols; x++)
+        {
+            int& id = point_ids[(size_t) y * (grid_cols + 1) + x];
+            if (id != -1)
+            {
+                continue;
+            }
+            bool off_mesh = true;
+            for (int c = 0; c < 4 && off_mesh; c++)
+            {
+                const int cx = x - (c & 1), cy = y - (c >> 1);
+                off_mesh = cx < 0 || cy < 0 || cx >= grid_cols ||
+                    cy >= grid_rows ||
+                    cell_polys[(size_t) cy * grid_cols + cx] == -1;
+            }
+            if (off_mesh)
+            {
+                id = off_mesh_id;
+                continue;
+            }
+            Point p = {min_x + x, min_y + y};
+            id = location_id(get_point_location_slab(p));
+        }
+    }
+    grid_vertex_locations = point_ids;
+    grid_cell_polygons = cell_polys;
+}
+
 // Finds out whether the polygon specified by "poly" contains point P.
 PolyContainment Mesh::poly_contains_point(int poly, Point& p)
 {
@@ -343,7 +929,45 @@ PolyContainment Mesh::poly_contains_point(int poly, Point& p)
 }
 
 // Finds where the point P lies in the mesh.
+// Lattice points and points well inside a unit cell are looked up in the
+// grid tables when the mesh has them; the rest go through the slabs.
 PointLocation Mesh::get_point_location(Point& p)
+{
+    if (grid_vertex_locations != nullptr)
+    {
+        const double fx = std::floor(p.x), fy = std::floor(p.y);
+        if (fx >= min_x && fx <= max_x && fy >= min_y && fy <= max_y)
+        {
+            const int x = (int) (fx - min_x), y = (int) (fy - min_y);
+            if (p.x == fx && p.y == fy)
+            {
+                return grid_locations[grid_vertex_locations[
+                    (size_t) y * (grid_cols + 1) + x]];
+            }
+            // Points within EPSILON of a cell's border may be on an edge.
+            const double dx = p.x - fx, dy = p.y - fy;
+            if (x < grid_cols && y < grid_rows &&
+                dx > EPSILON && dx < 1 - EPSILON &&
+                dy > EPSILON && dy < 1 - EPSILON)
+            {
+                const int poly =
+                    grid_cell_polygons[(size_t) y * grid_cols + x];
+                if (poly == -1)
+                {
+                    return {PointLocation::NOT_ON_MESH, -1, -1, -1, -1};
+                }
+                if (poly != GRID_CELL_SPLIT)
+                {
+                    return {PointLocation::IN_POLYGON, poly, -1, -1, -1};
+                }
+            }
+        }
+    }
+    return get_point_location_slab(p);
+}
+
+// Finds where the point P lies in the mesh by searching the slabs.
+PointLocation Mesh::get_point_location_slab(Point& p)
 {
     if (p.x < min_x - EPSILON || p.x > max_x + EPSILON ||
         p.y < min_y - EPSILON || p.y > max_y + EPSILON)
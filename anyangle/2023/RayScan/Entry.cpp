@@ -74,6 +74,22 @@ void *PrepareForSearch(const std::vector<bool> &bits, int width, int height, con
 	return g_rayscan.get();
 }
 
+/**
+ * Form of `PreprocessMap` taking the map packed into words, see Entry.h.
+ */
+void PreprocessMap(const GPPC::BitGrid &grid, const std::string &filename) {}
+
+/**
+ * Form of `PrepareForSearch` taking the map packed into words, see Entry.h.
+ * The grid and its transpose are copied into the search tables a word at a time.
+ */
+void *PrepareForSearch(const GPPC::BitGrid &grid, const std::string &filename) {
+	g_rayscan = std::make_unique<RayScan>();
+	g_rayscan->grid.setup(grid.bits, grid.stride, grid.transposed, grid.tstride, grid.width, grid.height);
+	g_rayscan->search.setup(g_rayscan->grid);
+	return g_rayscan.get();
+}
+
 /**
  * User code used to setup search before queries.  Can also load pre-processing data from file to speed load.
  * It will not be called in the same program execution as `PreprocessMap` is called,
@@ -23,6 +23,39 @@ void Grid::setup(const std::vector<bool> &bits, int width, int height)
 	}
 }
 
+void Grid::setup(const uint64_t* rows, size_t stride, const uint64_t* trows, size_t tstride, int width, int height)
+{
+	m_width = static_cast<uint32_t>(width) + 2*PADDING;
+	m_height = static_cast<uint32_t>(height) + 2*PADDING;
+	m_table[0].setup(m_width, m_height);
+	m_table[1].setup(m_height, m_width);
+	copy_rows(m_table[0], rows, stride, height);
+	if (trows != nullptr) {
+		copy_rows(m_table[1], trows, tstride, width);
+		return;
+	}
+	for (int y = 0; y < height; ++y)
+	for (int x = 0; x < width; ++x) {
+		if ((rows[y * stride + (x >> 6)] >> (x & 63)) & 1)
+			m_table[1].bit_or(y + static_cast<int>(PADDING), x + static_cast<int>(PADDING), 1);
+	}
+}
+
+void Grid::copy_rows(table& t, const uint64_t* rows, size_t stride, int height)
+{
+	static_assert(sizeof(table::pack_type) == sizeof(uint64_t) && PADDING < 64);
+	const size_t words = t.getRowWords();
+	table::pack_type* cells = t.data() + PADDING * words;
+	for (int y = 0; y < height; ++y, rows += stride, cells += words) {
+		uint64_t carry = 0;
+		for (size_t i = 0; i < words; ++i) {
+			uint64_t w = i < stride ? rows[i] : 0;
+			cells[i] = (w << PADDING) | carry;
+			carry = w >> (64 - PADDING);
+		}
+	}
+}
+
 void Grid::construct_vertices_aux(std::function<void(GridVertex)> vertexConstruct, uint32_t regionSize)
 {
 	// +1 width and height for lattice points
@@ -111,6 +111,9 @@ public:
 	Grid();
 
 	void setup(const std::vector<bool>& bits, int width, int height);
+	// rows/trows: the map and its transpose packed 64 tiles to a word, row y
+	// at rows + y*stride (the layout of GPPC::BitGrid); trows may be nullptr
+	void setup(const uint64_t* rows, size_t stride, const uint64_t* trows, size_t tstride, int width, int height);
 	template <typename VertexType>
 	void construct_vertices() requires std::is_base_of_v<GridVertex, VertexType>
 	{
@@ -140,6 +143,9 @@ public:
 	const auto& getVertexMap() const noexcept { return m_vertexMap; }
 
 protected:
+	// copy packed rows into t, moved PADDING tiles right and down
+	static void copy_rows(table& t, const uint64_t* rows, size_t stride, int height);
+
 	// construct turning vertices, grouping by regionSize squares
 	void construct_vertices_aux(std::function<void(GridVertex)> vertexConstruct, uint32_t regionSize = std::numeric_limits<uint32_t>::max() / 2);
 
@@ -137,6 +137,19 @@ bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path)
 	return true;
 }
 
+/**
+ * Batched form of `GetPath`, see Entry.h.  The abstraction is shared by all
+ * queries, so the batch is simply answered one query at a time.
+ */
+void GetPaths(void *data, const std::vector<std::pair<xyLoc, xyLoc>> &queries, std::vector<std::vector<xyLoc>> &paths)
+{
+	paths.resize(queries.size());
+	for (size_t i = 0; i < queries.size(); i++)
+	{
+		GetPath(data, queries[i].first, queries[i].second, paths[i]);
+	}
+}
+
 /**
  * The algorithm name.  Please update std::string and ensure name is immutable.
  * 
@@ -135,7 +135,7 @@ int ValidatePath(const std::vector<bool>& map, int width, int height, const Path
 			return static_cast<int>(i);
 	}
 	// check each segment
-	for (size_t i = 0; i < S-1; ++i) {
+	for (size_t i = 0; i + 1 < S; ++i) {
 		Point u{static_cast<int>(thePath[i].x), static_cast<int>(thePath[i].y)};
 		Point v{static_cast<int>(thePath[i+1].x), static_cast<int>(thePath[i+1].y)};
 		if (!validator.validEdge(u, v))
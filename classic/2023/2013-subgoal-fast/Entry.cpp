@@ -52,6 +52,15 @@ bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path)
 		c = entry.quickBucket->GetPath(s,g,path);
 	return true;
 }
+void GetPaths(void *data, const std::vector<std::pair<xyLoc, xyLoc>> &queries, std::vector<std::vector<xyLoc>> &paths)
+{
+	paths.resize(queries.size());
+	for (size_t i = 0; i < queries.size(); i++)
+	{
+		paths[i].clear();
+		GetPath(data, queries[i].first, queries[i].second, paths[i]);
+	}
+}
 void CleanUp()
 {
 	if (entry.useSubgoals)
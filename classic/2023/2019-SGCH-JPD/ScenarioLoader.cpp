@@ -24,50 +24,184 @@ SOFTWARE.
 using std::ifstream;
 using std::ofstream;
 
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "ScenarioLoader.h"
 
+namespace {
+
+/**
+ * Read-only view of a whole file. The file is mmapped; if that fails
+ * (e.g. a pipe or an empty file) it is read into memory instead.
+ */
+class MappedFile {
+public:
+  explicit MappedFile(const char *fname): data(nullptr), size(0), mapped(false)
+  {
+    int fd = open(fname, O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED) {
+        madvise(p, st.st_size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(p);
+        size = st.st_size;
+        mapped = true;
+      }
+    }
+    if (!mapped) {
+      char chunk[1 << 16];
+      ssize_t r;
+      while ((r = read(fd, chunk, sizeof(chunk))) > 0)
+        copy.insert(copy.end(), chunk, chunk + r);
+      data = copy.data();
+      size = copy.size();
+    }
+    close(fd);
+  }
+
+  ~MappedFile()
+  {
+    if (mapped) munmap(const_cast<char*>(data), size);
+  }
+
+  const char *begin() const { return data; }
+  const char *end() const { return data + size; }
+
+private:
+  MappedFile(const MappedFile&);
+  MappedFile &operator=(const MappedFile&);
+
+  const char *data;
+  size_t size;
+  bool mapped;
+  std::vector<char> copy;
+};
+
+/**
+ * Whitespace separated tokens of [p, end), in the manner of ifstream >>.
+ * Tokens are not null-terminated, since the mapping need not be.
+ */
+class Tokenizer {
+public:
+  Tokenizer(const char *b, const char *e): p(b), end(e) {}
+
+  bool Next(const char *&b, const char *&e)
+  {
+    while (p != end && IsSpace(*p)) ++p;
+    if (p == end) return false;
+    b = p;
+    while (p != end && !IsSpace(*p)) ++p;
+    e = p;
+    return true;
+  }
+
+  bool NextInt(int &v)
+  {
+    const char *b, *e;
+    if (!Next(b, e)) return false;
+    bool neg = *b == '-';
+    if (*b == '-' || *b == '+') ++b;
+    if (b == e) return false;
+    long long r = 0;
+    for (; b != e; ++b) {
+      if (*b < '0' || *b > '9') return false;
+      r = r * 10 + (*b - '0');
+    }
+    v = static_cast<int>(neg ? -r : r);
+    return true;
+  }
+
+  bool NextDouble(double &v)
+  {
+    const char *b, *e;
+    if (!Next(b, e)) return false;
+    // strtod needs a terminated string; numbers are short, so copy to the stack
+    char buf[64];
+    size_t n = e - b;
+    if (n >= sizeof(buf)) return false;
+    std::memcpy(buf, b, n);
+    buf[n] = 0;
+    char *last;
+    v = std::strtod(buf, &last);
+    return last == buf + n;
+  }
+
+  const char *Position() const { return p; }
+
+private:
+  static bool IsSpace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  const char *p, *end;
+};
+
+bool Equals(const char *b, const char *e, const char *word)
+{
+  size_t n = std::strlen(word);
+  return static_cast<size_t>(e - b) == n && std::memcmp(b, word, n) == 0;
+}
+
+}
+
 /** 
  * Loads the experiments from the scenario file. 
  */
 ScenarioLoader::ScenarioLoader(const char* fname)
 {
 	strncpy(scenName, fname, 1000);
-  ifstream sfile(fname,std::ios::in);
-  
-  float ver;
-  std::string first;
-  sfile>>first;
+  MappedFile sfile(fname);
+  Tokenizer in(sfile.begin(), sfile.end());
+
+  // one experiment per line, bar the version line
+  size_t lines = 0;
+  for (const char *p = sfile.begin(); (p = static_cast<const char*>(std::memchr(p, '\n', sfile.end() - p))) != nullptr; ++p)
+    ++lines;
+  experiments.reserve(lines + 1);
 
   // Check if a version number is given
-  if(first != "version"){
-    ver = 0.0;
-    sfile.seekg(0,std::ios::beg);
-  }
-  else{
-    sfile>>ver;
+  double ver = 0.0;
+  const char *b, *e;
+  Tokenizer first = in;
+  if (first.Next(b, e) && Equals(b, e, "version")) {
+    in = first;
+    if (!in.NextDouble(ver)) ver = -1;
   }
 
-  int sizeX = 0, sizeY = 0; 
+  int sizeX = kNoScaling, sizeY = kNoScaling;
   int bucket;
-  std::string map;  
   int xs, ys, xg, yg;
   double dist;
+  std::shared_ptr<const std::string> map;
+  std::vector<std::shared_ptr<const std::string>> maps;
 
   // Read in & store experiments
-  if (ver==0.0){
-    while(sfile>>bucket>>map>>xs>>ys>>xg>>yg>>dist) {
-      Experiment exp(xs,ys,xg,yg,bucket,dist,map);
-      experiments.push_back(exp);
-    }
+  if (ver != 0.0 && ver != 1.0) {
+    printf("Invalid version number.\n");
+    return;
   }
-  else if(ver==1.0){
-    while(sfile>>bucket>>map>>sizeX>>sizeY>>xs>>ys>>xg>>yg>>dist){
-      Experiment exp(xs,ys,xg,yg,sizeX,sizeY,bucket,dist,map);
-      experiments.push_back(exp);
+  while (in.NextInt(bucket) && in.Next(b, e)) {
+    if (!map || !Equals(b, e, map->c_str())) {
+      // scenario files rarely name more than one map; search the few we have
+      map.reset();
+      for (size_t i = 0; i < maps.size() && !map; i++)
+        if (Equals(b, e, maps[i]->c_str())) map = maps[i];
+      if (!map) {
+        map = std::make_shared<const std::string>(b, e);
+        maps.push_back(map);
+      }
     }
-  }
-  else{
-    printf("Invalid version number.\n");
+    if (ver == 1.0 && !(in.NextInt(sizeX) && in.NextInt(sizeY))) break;
+    if (!(in.NextInt(xs) && in.NextInt(ys) && in.NextInt(xg) && in.NextInt(yg) && in.NextDouble(dist))) break;
+    experiments.push_back(Experiment(xs,ys,xg,yg,sizeX,sizeY,bucket,dist,map));
   }
 }
 
@@ -82,7 +216,7 @@ void ScenarioLoader::Save(const char *fname)
 	
 	for (unsigned int x = 0; x < experiments.size(); x++)
 	{
-		ofile<<experiments[x].bucket<<"\t"<<experiments[x].map<<"\t"<<experiments[x].scaleX<<"\t";
+		ofile<<experiments[x].bucket<<"\t"<<*experiments[x].map<<"\t"<<experiments[x].scaleX<<"\t";
 		ofile<<experiments[x].scaleY<<"\t"<<experiments[x].startx<<"\t"<<experiments[x].starty<<"\t";
 		ofile<<experiments[x].goalx<<"\t"<<experiments[x].goaly<<"\t"<<experiments[x].distance<<std::endl;
 	}
@@ -93,3 +227,33 @@ void ScenarioLoader::AddExperiment(Experiment which)
 	experiments.push_back(which);
 }
 
+
+void LoadMap(const char *fname, std::vector<bool> &map, int &width, int &height, GPPC::PackedGrid *packed)
+{
+  MappedFile mfile(fname);
+  Tokenizer in(mfile.begin(), mfile.end());
+
+  // header: "type octile", "height h", "width w", then "map"
+  const char *b, *e;
+  width = height = 0;
+  while (in.Next(b, e) && !Equals(b, e, "map")) {
+    if (Equals(b, e, "height")) in.NextInt(height);
+    else if (Equals(b, e, "width")) in.NextInt(width);
+  }
+  if (width <= 0 || height <= 0) return;
+
+  // tiles are read row after row, skipping any whitespace between them
+  map.assign(static_cast<size_t>(height) * width, false);
+  if (packed) packed->Resize(width, height);
+  std::vector<bool>::iterator it = map.begin(), ite = map.end();
+  int x = 0, y = 0;
+  for (const char *p = in.Position(), *pe = mfile.end(); p != pe && it != ite; ++p) {
+    char c = *p;
+    if (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f') continue;
+    bool traversable = (c == '.' || c == 'G' || c == 'S');
+    *it++ = traversable;
+    if (packed && traversable) packed->Set(x, y);
+    if (++x == width) { x = 0; ++y; }
+  }
+  if (packed) packed->Transpose();
+}
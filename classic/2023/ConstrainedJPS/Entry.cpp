@@ -22,6 +22,10 @@ SOFTWARE.
 
 #include "Entry.h"
 
+// nodes expanded and generated since the last GetSearchStats call; the
+// search state already lives in globals (see global.h), so these do too
+static uint64_t stats_expanded = 0, stats_generated = 0;
+
 /**
  * User code used during preprocessing of a map.  Can be left blank if no pre-processing is required.
  * It will not be called in the same program execution as `PrepareForSearch` is called,
@@ -112,6 +116,8 @@ bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path) {
   warthog::problem_instance pi(startid, goalid, false);
   warthog::solution sol;
   astar->get_path(pi, sol);
+  stats_expanded += sol.nodes_expanded_;
+  stats_generated += sol.nodes_touched_;
 
   path.push_back(s);
   for (size_t i=1; i<sol.path_.size(); i++) {
@@ -133,6 +139,26 @@ bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path) {
   return true;
 }
 
+/**
+ * Batched form of `GetPath`, see Entry.h.  Each query is answered on its own.
+ */
+void GetPaths(void *data, const std::vector<std::pair<xyLoc, xyLoc>> &queries, std::vector<std::vector<xyLoc>> &paths) {
+  paths.resize(queries.size());
+  for (size_t i = 0; i < queries.size(); i++) {
+    paths[i].clear();
+    GetPath(data, queries[i].first, queries[i].second, paths[i]);
+  }
+}
+
+/**
+ * Search counts for the -bench mode of main.cpp, see Entry.h.
+ */
+void GetSearchStats(void *, uint64_t &expanded, uint64_t &generated) {
+  expanded += stats_expanded;
+  generated += stats_generated;
+  stats_expanded = stats_generated = 0;
+}
+
 /**
  * The algorithm name.  Please update std::string and ensure name is immutable.
  * 
@@ -1,63 +1,185 @@
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
 #include "Entry.h"
 #include <domains/gridmap.h>
 #include <search/gridmap_expansion_policy.h>
 #include <search/flexible_astar.h>
 #include <heuristics/octile_heuristic.h>
-#include <util/pqueue.h>
+#include <util/bucket_queue.h>
 
-struct WarthogAlg
+// read-only map data. built once per map and shared by every search
+// context created for that map.
+struct WarthogMap
 {
 	warthog::gridmap map;
+
+	WarthogMap(const std::vector<bool>& bits, int width, int height) : map(bits.begin(), bits.end(), height, width)
+	{ }
+
+	// the map arrives packed, so it is copied a word at a time
+	WarthogMap(const GPPC::BitGrid& grid) : map(grid.bits, grid.stride, grid.height, grid.width)
+	{ }
+};
+
+// per-thread search state: node pool, open list and search numbers.
+struct WarthogAlg
+{
+	std::shared_ptr<WarthogMap> shared;
 	warthog::gridmap_expansion_policy expander;
 	warthog::octile_heuristic heuristic;
-	warthog::pqueue_min open;
+	warthog::bucket_queue open;
 
 	warthog::flexible_astar<
 	warthog::octile_heuristic,
 	warthog::gridmap_expansion_policy, 
-	warthog::pqueue_min> 
+	warthog::bucket_queue> 
 	astar;
 	warthog::solution sol;
+	uint32_t search_number;
+	// nodes expanded and generated since the last GetSearchStats call
+	uint64_t expanded, generated;
+
+	// node pool limits: recycle blocks no search has used for the last
+	// POOL_MAX_IDLE queries, and start afresh above POOL_MAX_BYTES
+	static const size_t POOL_MAX_BYTES = 256u << 20;
+	static const uint32_t POOL_MAX_IDLE = 256;
 
-	WarthogAlg(const std::vector<bool>& bits, int width, int height) : map(bits.begin(), bits.end(), height, width)
-		,expander(&map)
-		,heuristic(map.width(), map.height())
+	WarthogAlg(std::shared_ptr<WarthogMap> data) : shared(std::move(data))
+		,expander(&shared->map)
+		,heuristic(shared->map.width(), shared->map.height())
 		,astar(&heuristic, &expander, &open)
-	{ }
+		,search_number(0)
+		,expanded(0)
+		,generated(0)
+	{
+		expander.set_pool_limits(POOL_MAX_BYTES, POOL_MAX_IDLE);
+	}
 };
 
-void PreprocessMap(const std::vector<bool> &bits, int width, int height, const std::string &filename) {
+// PrepareForSearch may be called once per search thread; every call for
+// the same map returns a new context on top of the same WarthogMap.
+// @param args: passed on to the WarthogMap constructor
+template <typename... Args>
+static std::shared_ptr<WarthogMap> GetSharedMap(const std::string& filename, const Args&... args)
+{
+	static std::mutex lock;
+	static std::map<std::string, std::weak_ptr<WarthogMap>> maps;
+	std::lock_guard<std::mutex> guard(lock);
+	std::shared_ptr<WarthogMap> data = maps[filename].lock();
+	if (!data) {
+		data = std::make_shared<WarthogMap>(args...);
+		maps[filename] = data;
+	}
+	return data;
+}
+
+void PreprocessMap(const std::vector<bool> &, int, int, const std::string &) {
 	
 }
 
 void *PrepareForSearch(const std::vector<bool> &bits, int width, int height, const std::string &filename) {
-	return new WarthogAlg(bits, width, height);
+	return new WarthogAlg(GetSharedMap(filename, bits, width, height));
+}
+
+void *PrepareForSearch(const GPPC::BitGrid &grid, const std::string &filename) {
+	return new WarthogAlg(GetSharedMap(filename, grid));
+}
+
+static void CountSearch(WarthogAlg* alg, const warthog::solution& sol) {
+	alg->expanded += sol.met_.nodes_expanded_;
+	alg->generated += sol.met_.nodes_generated_;
+}
+
+static void ToPath(warthog::gridmap& map, const warthog::solution& sol, std::vector<xyLoc> &path) {
+	const auto width = static_cast<warthog::sn_id_t>(map.header_width());
+	path.resize(sol.path_.size());
+	auto jt = sol.path_.begin();
+	for (auto it = path.begin(), ite = path.end(); it != ite; ++it, ++jt) {
+		xyLoc xy;
+		auto j = map.to_unpadded_id(*jt);
+		xy.x = static_cast<int16_t>(j % width);
+		xy.y = static_cast<int16_t>(j / width);
+		*it = xy;
+	}
 }
 
 bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path) {
 	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
 	
-	const auto width = static_cast<warthog::sn_id_t>(alg->map.header_width());
+	warthog::gridmap& map = alg->shared->map;
+	const auto width = static_cast<warthog::sn_id_t>(map.header_width());
 	warthog::sn_id_t startid =static_cast<warthog::sn_id_t>(s.y) * width + static_cast<warthog::sn_id_t>(s.x);
 	warthog::sn_id_t goalid = static_cast<warthog::sn_id_t>(g.y) * width + static_cast<warthog::sn_id_t>(g.x);
-	warthog::problem_instance pi(startid, goalid, false);
+	warthog::problem_instance pi(startid, goalid, alg->search_number++, false);
 
 	alg->astar.get_path(pi, alg->sol);
+	CountSearch(alg, alg->sol);
 	if (alg->sol.path_.empty())
 		return true;
 	
-	path.resize(alg->sol.path_.size());
-	auto jt = alg->sol.path_.begin();
-	for (auto it = path.begin(), ite = path.end(); it != ite; ++it, ++jt) {
-		xyLoc xy;
-		auto j = alg->map.to_unpadded_id(*jt);
-		xy.x = static_cast<int16_t>(j % width);
-		xy.y = static_cast<int16_t>(j / width);
-		*it = xy;
-	}
+	ToPath(map, alg->sol, path);
 	return true;
 }
 
+// queries with the same start are answered by one search that is resumed
+// for each goal (see flexible_astar::get_paths).
+void GetPaths(void *data, const std::vector<std::pair<xyLoc, xyLoc>> &queries, std::vector<std::vector<xyLoc>> &paths) {
+	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
+
+	warthog::gridmap& map = alg->shared->map;
+	const auto width = static_cast<warthog::sn_id_t>(map.header_width());
+	std::vector<size_t> order(queries.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&queries](size_t a, size_t b) {
+		const xyLoc& sa = queries[a].first;
+		const xyLoc& sb = queries[b].first;
+		return sa.y < sb.y || (sa.y == sb.y && sa.x < sb.x);
+	});
+
+	paths.resize(queries.size());
+	std::vector<warthog::sn_id_t> targets;
+	std::vector<warthog::solution> sols;
+	for (size_t i = 0, j; i < order.size(); i = j) {
+		xyLoc s = queries[order[i]].first;
+		targets.clear();
+		for (j = i; j < order.size() && queries[order[j]].first.x == s.x && queries[order[j]].first.y == s.y; j++) {
+			xyLoc g = queries[order[j]].second;
+			targets.push_back(static_cast<warthog::sn_id_t>(g.y) * width + static_cast<warthog::sn_id_t>(g.x));
+		}
+
+		warthog::sn_id_t startid = static_cast<warthog::sn_id_t>(s.y) * width + static_cast<warthog::sn_id_t>(s.x);
+		warthog::problem_instance pi(startid, warthog::SN_ID_MAX, alg->search_number++, false);
+		alg->astar.get_paths(pi, targets, sols);
+		for (size_t k = i; k < j; k++) {
+			CountSearch(alg, sols[k - i]);
+			paths[order[k]].clear();
+			ToPath(map, sols[k - i], paths[order[k]]);
+		}
+	}
+}
+
+void GetSearchStats(void *data, uint64_t &expanded, uint64_t &generated) {
+	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
+	expanded += alg->expanded;
+	generated += alg->generated;
+	alg->expanded = alg->generated = 0;
+}
+
+// contexts share only the read-only WarthogMap
+bool ThreadSafeSearch() { return true; }
+
+// the shared map goes with the last context using it
+void ReleaseSearch(void *data) {
+	delete static_cast<WarthogAlg*>(data);
+}
+
+// astar.mem() covers the open list, the node pool and, through the expander, the map
+size_t GetMemoryUsage(void *data) {
+	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
+	return sizeof(WarthogAlg) + alg->astar.mem();
+}
+
 std::string GetName() { return "Warthog-A*"; }
@@ -25,6 +25,8 @@ SOFTWARE.
 
 #include <vector>
 #include <string>
+#include <utility>
+#include <cstdint>
 
 // include common used class in GPPC
 #include "GPPC.h"
@@ -49,6 +51,48 @@ e.g.:
 */
 bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path);
 
+/*
+batched form of GetPath: paths[i] receives the complete path for queries[i] = (s, g),
+or an empty path if none exists.
+engines may reorder the batch or share work between its queries (e.g. queries with the
+same start), but each paths[i] must be a path GetPath would accept for that query.
+*/
+void GetPaths(void *data, const std::vector<std::pair<xyLoc, xyLoc>> &queries, std::vector<std::vector<xyLoc>> &paths);
+
 std::string GetName();
 
+/*
+optional forms of PreprocessMap and PrepareForSearch that take the map packed into
+64-bit words (see GPPC::BitGrid), for engines that copy it by the word or read it in
+place. the grid stays valid until ReleaseSearch is called on the data prepared from
+it, or the program exits. when an entry defines them, they are called instead of the
+std::vector<bool> forms.
+*/
+void PreprocessMap(const GPPC::BitGrid &grid, const std::string &filename) __attribute__((weak));
+void *PrepareForSearch(const GPPC::BitGrid &grid, const std::string &filename) __attribute__((weak));
+
+/*
+optional: adds to expanded and generated the number of nodes the searches on data
+expanded and generated since the previous call; used by the -bench mode of main.cpp.
+entries that keep no such counts leave it undefined and report zeros.
+*/
+void GetSearchStats(void *data, uint64_t &expanded, uint64_t &generated) __attribute__((weak));
+
+/*
+optional, for the -serve mode of main.cpp, which keeps the search data of many maps
+and drops the least recently used when over its memory budget. ReleaseSearch frees
+data returned by PrepareForSearch; -serve is refused for entries without it.
+GetMemoryUsage returns the bytes held by data; without it, -serve charges each map
+the growth of the resident set while it was prepared.
+*/
+void ReleaseSearch(void *data) __attribute__((weak));
+size_t GetMemoryUsage(void *data) __attribute__((weak));
+
+/*
+optional: returns true if searches on different data returned by PrepareForSearch
+may run at the same time, one thread per data. the -threads option of main.cpp is
+refused for entries without it, since they may keep search state in globals.
+*/
+bool ThreadSafeSearch() __attribute__((weak));
+
 #endif // GPPC_ENTRY_H
@@ -26,6 +26,8 @@ SOFTWARE.
 #include <vector>
 #include <cstring>
 #include <string>
+#include <memory>
+#include "GPPC.h"
 
 static const int kNoScaling = -1;
 
@@ -37,17 +39,17 @@ class ScenarioLoader;
 class Experiment {
 public:
 	Experiment(int sx,int sy,int gx,int gy,int b, double d, std::string m)
-    :startx(sx),starty(sy),goalx(gx),goaly(gy),scaleX(kNoScaling),scaleY(kNoScaling),bucket(b),distance(d),map(m){}
+    :startx(sx),starty(sy),goalx(gx),goaly(gy),scaleX(kNoScaling),scaleY(kNoScaling),bucket(b),distance(d),map(std::make_shared<const std::string>(m)){}
 	Experiment(int sx,int sy,int gx,int gy,int sizeX, int sizeY,int b, double d, std::string m)
-    :startx(sx),starty(sy),goalx(gx),goaly(gy),scaleX(sizeX),scaleY(sizeY),bucket(b),distance(d),map(m){}
+    :startx(sx),starty(sy),goalx(gx),goaly(gy),scaleX(sizeX),scaleY(sizeY),bucket(b),distance(d),map(std::make_shared<const std::string>(m)){}
 	int GetStartX() const {return startx;}
 	int GetStartY() const {return starty;}
 	int GetGoalX() const {return goalx;}
 	int GetGoalY() const {return goaly;}
 	int GetBucket() const {return bucket;}
 	double GetDistance() const {return distance;}
-	void GetMapName(char* mymap) const {strcpy(mymap,map.c_str());}
-	const char *GetMapName() const { return map.c_str(); }
+	void GetMapName(char* mymap) const {strcpy(mymap,map->c_str());}
+	const char *GetMapName() const { return map->c_str(); }
 	int GetXScale() const {return scaleX;}
 	int GetYScale() const {return scaleY;}
 	
@@ -58,11 +60,17 @@ private:
 	int scaleY;
 	int bucket;
 	double distance;
-	std::string map;
+	// experiments loaded from the same file share one copy of each map name
+	std::shared_ptr<const std::string> map;
+
+	Experiment(int sx,int sy,int gx,int gy,int sizeX, int sizeY,int b, double d, std::shared_ptr<const std::string> m)
+    :startx(sx),starty(sy),goalx(gx),goaly(gy),scaleX(sizeX),scaleY(sizeY),bucket(b),distance(d),map(std::move(m)){}
 };
 
 /** A class which loads and stores scenarios from files.  
  * Versions currently handled: 0.0 and 1.0 (includes scale). 
+ * The file is mapped into memory and parsed in place; rows only allocate
+ * when the experiments vector grows or a new map name appears.
  */
 
 class ScenarioLoader{
@@ -72,7 +80,7 @@ public:
 	void Save(const char *);
 	int GetNumExperiments(){return experiments.size();}
 	const char *GetScenarioName() { return scenName; }
-	Experiment GetNthExperiment(int which)
+	const Experiment &GetNthExperiment(int which) const
 	{return experiments[which];}
 	void AddExperiment(Experiment which);
 private:
@@ -80,4 +88,10 @@ private:
 	std::vector<Experiment> experiments;
 };
 
+/** Loads an octile map; in @map, true is traversable and false an obstacle.
+ * Like ScenarioLoader, it parses the file in place after mapping it.
+ * If @packed is given, it also receives the map, transposed copy included.
+ */
+void LoadMap(const char *fname, std::vector<bool> &map, int &width, int &height, GPPC::PackedGrid *packed = nullptr);
+
 #endif // GPPC_SCENARIOLOADER_H
@@ -9,6 +9,57 @@ warthog::gridmap::gridmap(unsigned int h, unsigned int w)
 	this->init_db();
 }
 
+// reverses the order of the bits in a word
+static inline uint64_t
+reverse64(uint64_t v)
+{
+	v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+	v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+	v = ((v >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((v & 0x0F0F0F0F0F0F0F0Full) << 4);
+	return __builtin_bswap64(v);
+}
+
+warthog::gridmap::gridmap(const uint64_t* rows, uint32_t stride,
+		uint32_t h, uint32_t w, bool reverse)
+	: header_(h, w, "octile")
+{
+	this->init_db();
+	assert(stride >= dbwidth64_);
+
+	// db_ keeps tile x of a row in bit x of the row, as rows does; both
+	// are read as little-endian 64bit words (cf. get_neighbours_64bit)
+	uint64_t* db64 = (uint64_t*)db_;
+	num_traversable_ = 0;
+	for(uint32_t y = 0; y < h; y++)
+	{
+		const uint64_t* src = rows + (size_t)y * stride;
+		uint64_t* dst = db64 +
+			(size_t)(y + padded_rows_before_first_row_) * dbwidth64_;
+		if(!reverse)
+		{
+			memcpy(dst, src, dbwidth64_ * sizeof(uint64_t));
+		}
+		else
+		{
+			// word k of the reversed row is reverse64(src[stride-1-k]) and
+			// has tile x at bit x + shift
+			uint32_t shift = stride * 64 - w;
+			for(uint32_t i = 0; i < dbwidth64_; i++)
+			{
+				uint32_t k = (i * 64 + shift) >> 6;
+				uint32_t off = (i * 64 + shift) & 63;
+				uint64_t lo = k < stride ? reverse64(src[stride-1-k]) : 0;
+				uint64_t hi = k + 1 < stride ? reverse64(src[stride-2-k]) : 0;
+				dst[i] = off ? (lo >> off) | (hi << (64 - off)) : lo;
+			}
+		}
+		for(uint32_t i = 0; i < dbwidth64_; i++)
+		{
+			num_traversable_ += __builtin_popcountll(dst[i]);
+		}
+	}
+}
+
 warthog::gridmap::gridmap(const char* filename)
 {
 	strcpy(filename_, filename);
@@ -43,6 +43,14 @@ class gridmap
 		{
 			loadData(beg, ed);
 		}
+		// @param rows: the tiles packed one bit each into 64-bit words, with
+		// rows @param stride words apart, tile x of a row in bit x % 64 of
+		// word x / 64 and zero bits past the last tile. rows are copied a
+		// word at a time. with @param reverse each row is read back to front
+		// (tile x from bit width-1-x), which turns a transposed copy of a map
+		// into the map rotated clockwise (cf. online_jump_point_locator2).
+		gridmap(const uint64_t* rows, uint32_t stride, uint32_t height,
+				uint32_t width, bool reverse = false);
 		~gridmap();
 		gridmap& operator=(const warthog::gridmap& other) = delete;
 
@@ -208,6 +216,18 @@ class gridmap
 			tiles[2] = *((uint64_t*)(db_)+pos3);
 		}
 
+		// similar to get_neighbours_64bit but returns the addresses of the
+		// three 64bit words instead of their contents. this variant is
+		// useful for scanning several words of each row at once.
+		inline void
+		get_neighbours_64bit_ptr(uint32_t grid_id_p, const uint64_t* rows[3])
+		{
+			uint32_t dbindex = grid_id_p >> 6;
+			rows[0] = (uint64_t*)(db_) + (dbindex - dbwidth64_);
+			rows[1] = (uint64_t*)(db_) + dbindex;
+			rows[2] = (uint64_t*)(db_) + (dbindex + dbwidth64_);
+		}
+
 		// get the label associated with the padded coordinate pair (x, y)
 		inline bool
 		get_label(uint32_t x, unsigned int y)
@@ -51,7 +51,7 @@ warthog::graph::gridmap_to_xy_graph(
 
             warthog::search_node* nei = 0;
             warthog::search_node* n = 0;
-            edge_cost_t edge_cost = 0;
+            warthog::cost_t edge_cost = 0;
 
             n = exp.generate(gm->to_padded_id(y*gm->header_width() + x));
             exp.expand(n, 0);
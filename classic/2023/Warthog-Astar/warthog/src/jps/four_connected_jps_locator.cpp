@@ -21,7 +21,7 @@ warthog::four_connected_jps_locator::~four_connected_jps_locator()
 void
 warthog::four_connected_jps_locator::jump(warthog::jps::direction d,
 	   	uint32_t node_id, uint32_t goal_id, uint32_t& jumpnode_id, 
-		double& jumpcost)
+		warthog::cost_t& jumpcost)
 {
 	switch(d)
 	{
@@ -40,19 +40,21 @@ warthog::four_connected_jps_locator::jump(warthog::jps::direction d,
 		default:
 			break;
 	}
+	// the jumps above count steps
+	jumpcost *= warthog::CARD_COST;
 }
 
 void
 warthog::four_connected_jps_locator::jump_north(uint32_t node_id, 
-		uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+		uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
     uint32_t num_steps = 0;
     uint32_t mapw = map_->width();
 
     uint32_t jp_w_id;
     uint32_t jp_e_id;
-    double jp_w_cost;
-    double jp_e_cost;
+    warthog::cost_t jp_w_cost;
+    warthog::cost_t jp_e_cost;
 
     uint32_t next_id = node_id;
     while(true)
@@ -80,15 +82,15 @@ warthog::four_connected_jps_locator::jump_north(uint32_t node_id,
 
 void
 warthog::four_connected_jps_locator::jump_south(uint32_t node_id, 
-		uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+		uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
     uint32_t num_steps = 0;
     uint32_t mapw = map_->width();
 
     uint32_t jp_w_id;
     uint32_t jp_e_id;
-    double jp_w_cost;
-    double jp_e_cost;
+    warthog::cost_t jp_w_cost;
+    warthog::cost_t jp_e_cost;
 
     uint32_t next_id = node_id;
     while(true)
@@ -115,7 +117,7 @@ warthog::four_connected_jps_locator::jump_south(uint32_t node_id,
 
 void
 warthog::four_connected_jps_locator::jump_east(uint32_t node_id, 
-		uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+		uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	jumpnode_id = node_id;
 
@@ -180,7 +182,7 @@ warthog::four_connected_jps_locator::jump_east(uint32_t node_id,
 
 void
 warthog::four_connected_jps_locator::jump_west(uint32_t node_id, 
-		uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+		uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	bool deadend = false;
 	uint32_t neis[3] = {0, 0, 0};
@@ -28,6 +28,10 @@ class jps2_expansion_policy : public expansion_policy
 {
 	public:
 		jps2_expansion_policy(warthog::gridmap* map);
+
+		// jump using a rotated copy of @param map that is shared with
+		// other policies; see online_jump_point_locator2::create_rmap
+		jps2_expansion_policy(warthog::gridmap* map, warthog::gridmap* rmap);
 		virtual ~jps2_expansion_policy();
 
 		virtual void 
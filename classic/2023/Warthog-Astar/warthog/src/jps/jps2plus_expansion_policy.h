@@ -26,6 +26,12 @@ class jps2plus_expansion_policy : public expansion_policy
 {
 	public:
 		jps2plus_expansion_policy(warthog::gridmap* map);
+		jps2plus_expansion_policy(warthog::gridmap* map, const std::string& preFilename);
+
+		// use a jump point database loaded elsewhere. @param jpl is not
+		// owned by the policy and can be shared by several policies.
+		jps2plus_expansion_policy(warthog::gridmap* map, 
+				warthog::offline_jump_point_locator2* jpl);
 		virtual ~jps2plus_expansion_policy();
 
 		virtual void 
@@ -52,7 +58,8 @@ class jps2plus_expansion_policy : public expansion_policy
 	private:
 		warthog::gridmap* map_;
 		offline_jump_point_locator2* jpl_;
-		std::vector<double> costs_;
+		bool owns_jpl_;
+		std::vector<warthog::cost_t> costs_;
 		std::vector<uint32_t> jp_ids_;
 
 		// computes the direction of travel; from a node n1
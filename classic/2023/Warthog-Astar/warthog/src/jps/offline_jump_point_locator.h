@@ -24,7 +24,7 @@ class offline_jump_point_locator
 
 		void
 		jump(warthog::jps::direction d, uint32_t node_id, uint32_t goalid, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 
 		uint32_t
 		mem()
@@ -46,28 +46,28 @@ class offline_jump_point_locator
 
 		void
 		jump_northwest(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_northeast(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_southwest(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_southeast(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_north(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_south(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_east(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_west(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 
 		warthog::gridmap* map_;
 		uint32_t dbsize_;
@@ -14,6 +14,7 @@
 //
 
 #include "jps.h"
+#include "jump_table.h"
 
 namespace warthog
 {
@@ -23,16 +24,17 @@ class offline_jump_point_locator2
 {
 	public:
 		offline_jump_point_locator2(warthog::gridmap* map);
+		offline_jump_point_locator2(warthog::gridmap* map, const std::string& preFilename);
 		~offline_jump_point_locator2();
 
 		void
 		jump(warthog::jps::direction d, uint32_t node_id, uint32_t goalid, 
-				std::vector<uint32_t>& neighbours, std::vector<double>& costs);
+				std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs);
 
 		uint32_t
 		mem()
 		{
-			return sizeof(this) + sizeof(*db_)*dbsize_;
+			return sizeof(this) + table_.mem();
 		}
 
 
@@ -42,39 +44,39 @@ class offline_jump_point_locator2
 		preproc();
 
 		bool
-		load(const char* filename);
+		load(const char* filename, bool append = true);
 
 		void 
-		save(const char* filename);
+		save(const char* filename, bool append = true);
 
 		void
 		jump_northwest(uint32_t node_id, uint32_t goal_id, 
-				std::vector<uint32_t>& neighbours, std::vector<double>& costs);
+				std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs);
 		void
 		jump_northeast(uint32_t node_id, uint32_t goal_id, 
-				std::vector<uint32_t>& neighbours, std::vector<double>& costs);
+				std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs);
 		void
 		jump_southwest(uint32_t node_id, uint32_t goal_id, 
-				std::vector<uint32_t>& neighbours, std::vector<double>& costs);
+				std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs);
 		void
 		jump_southeast(uint32_t node_id, uint32_t goal_id, 
-				std::vector<uint32_t>& neighbours, std::vector<double>& costs);
+				std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs);
 		void
-		jump_north(uint32_t node_id, uint32_t goal_id, double cost_to_node_id,
-				std::vector<uint32_t>& neighbours, std::vector<double>& costs);
+		jump_north(uint32_t node_id, uint32_t goal_id, warthog::cost_t cost_to_node_id,
+				std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs);
 		void
-		jump_south(uint32_t node_id, uint32_t goal_id, double cost_to_node_id,
-				std::vector<uint32_t>& neighbours, std::vector<double>& costs);
+		jump_south(uint32_t node_id, uint32_t goal_id, warthog::cost_t cost_to_node_id,
+				std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs);
 		void
-		jump_east(uint32_t node_id, uint32_t goal_id, double cost_to_node_id,
-				std::vector<uint32_t>& neighbours, std::vector<double>& costs);
+		jump_east(uint32_t node_id, uint32_t goal_id, warthog::cost_t cost_to_node_id,
+				std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs);
 		void
-		jump_west(uint32_t node_id, uint32_t goal_id, double cost_to_node_id,
-				std::vector<uint32_t>& neighbours, std::vector<double>& costs);
+		jump_west(uint32_t node_id, uint32_t goal_id, warthog::cost_t cost_to_node_id,
+				std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs);
 
 		warthog::gridmap* map_;
-		uint32_t dbsize_;
-		uint16_t* db_;	
+		warthog::jps::jump_table table_;
+		std::string preFilename_;
 };
 
 }
@@ -65,6 +65,7 @@ class online_jump_point_locator
 		// these versions can be passed a map parameter to
 		// use when jumping. they allow switching between
 		// map_ and rmap_ (a rotated counterpart).
+		// @param jumpcost: the number of steps taken
 		void
 		__jump_east(uint32_t node_id, uint32_t goal_id, 
 				uint32_t& jumpnode_id, warthog::cost_t& jumpcost, 
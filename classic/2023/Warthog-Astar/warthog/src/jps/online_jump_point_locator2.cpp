@@ -4,27 +4,188 @@
 
 #include <cassert>
 #include <climits>
+#include <immintrin.h>
+
+// Vectorised scans for long horizontal jumps. Starting from the
+// word-aligned tile at rows[1], each function skips over blocks of 256
+// (AVX2) or 512 (AVX-512) tiles in which the middle row has no obstacles
+// and the rows above and below have no forced neighbours. The scan stops
+// at the first block that has any; the scalar loop then finds the stop
+// tile inside it.
+//
+// Reads can run up to one block past the end of the current row: the
+// middle row always stops at the padding column, and the grid has three
+// padding rows above and below, so the reads stay in the grid as long as
+// a row holds at least one block (see WIDE_SCAN_MIN_WIDTH).
+//
+// @return the number of tiles skipped
+typedef uint32_t (*wide_scan_fn)(const uint64_t* rows[3]);
+static const uint32_t WIDE_SCAN_MIN_WIDTH = 512;
+
+__attribute__((target("avx2")))
+static uint32_t
+scan_east_avx2(const uint64_t* rows[3])
+{
+	const __m256i ones = _mm256_set1_epi64x(-1);
+	int32_t i = 0;
+	while(true)
+	{
+		// a tile is forced if it is traversable and its western
+		// neighbour is not; the west neighbour of bit 0 is the high
+		// bit of the previous word
+		__m256i a = _mm256_loadu_si256((const __m256i*)(rows[0] + i));
+		__m256i a_prev = _mm256_loadu_si256((const __m256i*)(rows[0] + i - 1));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(rows[2] + i));
+		__m256i b_prev = _mm256_loadu_si256((const __m256i*)(rows[2] + i - 1));
+		__m256i m = _mm256_loadu_si256((const __m256i*)(rows[1] + i));
+
+		__m256i forced = _mm256_andnot_si256(_mm256_or_si256(
+				_mm256_slli_epi64(a, 1), _mm256_srli_epi64(a_prev, 63)), a);
+		forced = _mm256_or_si256(forced, _mm256_andnot_si256(_mm256_or_si256(
+				_mm256_slli_epi64(b, 1), _mm256_srli_epi64(b_prev, 63)), b));
+
+		// keep going while no tile is forced or blocked
+		if(!_mm256_testc_si256(_mm256_andnot_si256(forced, m), ones)) { break; }
+		i += 4;
+	}
+	return i*64;
+}
+
+// analogous to scan_east_avx2; rows[1] is the highest word of each block
+__attribute__((target("avx2")))
+static uint32_t
+scan_west_avx2(const uint64_t* rows[3])
+{
+	const __m256i ones = _mm256_set1_epi64x(-1);
+	int32_t i = 0;
+	while(true)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i*)(rows[0] + i - 3));
+		__m256i a_next = _mm256_loadu_si256((const __m256i*)(rows[0] + i - 2));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(rows[2] + i - 3));
+		__m256i b_next = _mm256_loadu_si256((const __m256i*)(rows[2] + i - 2));
+		__m256i m = _mm256_loadu_si256((const __m256i*)(rows[1] + i - 3));
+
+		__m256i forced = _mm256_andnot_si256(_mm256_or_si256(
+				_mm256_srli_epi64(a, 1), _mm256_slli_epi64(a_next, 63)), a);
+		forced = _mm256_or_si256(forced, _mm256_andnot_si256(_mm256_or_si256(
+				_mm256_srli_epi64(b, 1), _mm256_slli_epi64(b_next, 63)), b));
+
+		if(!_mm256_testc_si256(_mm256_andnot_si256(forced, m), ones)) { break; }
+		i -= 4;
+	}
+	return -i*64;
+}
+
+// GCC 12 fills the unused merge operand of the unmasked AVX-512 shift and
+// logic intrinsics with _mm512_undefined_epi32(), which it then reports
+// as used uninitialized once they are inlined here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+__attribute__((target("avx512f")))
+static uint32_t
+scan_east_avx512(const uint64_t* rows[3])
+{
+	const __m512i ones = _mm512_set1_epi64(-1);
+	int32_t i = 0;
+	while(true)
+	{
+		__m512i a = _mm512_loadu_si512(rows[0] + i);
+		__m512i a_prev = _mm512_loadu_si512(rows[0] + i - 1);
+		__m512i b = _mm512_loadu_si512(rows[2] + i);
+		__m512i b_prev = _mm512_loadu_si512(rows[2] + i - 1);
+		__m512i m = _mm512_loadu_si512(rows[1] + i);
+
+		__m512i forced = _mm512_andnot_si512(_mm512_or_si512(
+				_mm512_slli_epi64(a, 1), _mm512_srli_epi64(a_prev, 63)), a);
+		forced = _mm512_or_si512(forced, _mm512_andnot_si512(_mm512_or_si512(
+				_mm512_slli_epi64(b, 1), _mm512_srli_epi64(b_prev, 63)), b));
+
+		if(_mm512_cmpneq_epi64_mask(_mm512_andnot_si512(forced, m), ones))
+		{
+			break;
+		}
+		i += 8;
+	}
+	return i*64;
+}
+
+__attribute__((target("avx512f")))
+static uint32_t
+scan_west_avx512(const uint64_t* rows[3])
+{
+	const __m512i ones = _mm512_set1_epi64(-1);
+	int32_t i = 0;
+	while(true)
+	{
+		__m512i a = _mm512_loadu_si512(rows[0] + i - 7);
+		__m512i a_next = _mm512_loadu_si512(rows[0] + i - 6);
+		__m512i b = _mm512_loadu_si512(rows[2] + i - 7);
+		__m512i b_next = _mm512_loadu_si512(rows[2] + i - 6);
+		__m512i m = _mm512_loadu_si512(rows[1] + i - 7);
+
+		__m512i forced = _mm512_andnot_si512(_mm512_or_si512(
+				_mm512_srli_epi64(a, 1), _mm512_slli_epi64(a_next, 63)), a);
+		forced = _mm512_or_si512(forced, _mm512_andnot_si512(_mm512_or_si512(
+				_mm512_srli_epi64(b, 1), _mm512_slli_epi64(b_next, 63)), b));
+
+		if(_mm512_cmpneq_epi64_mask(_mm512_andnot_si512(forced, m), ones))
+		{
+			break;
+		}
+		i -= 8;
+	}
+	return -i*64;
+}
+#pragma GCC diagnostic pop
+
+// pick the widest scan the cpu supports; 0 keeps the scalar loop only
+static wide_scan_fn
+select_wide_scan(bool east)
+{
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx512f"))
+	{
+		return east ? scan_east_avx512 : scan_west_avx512;
+	}
+	if(__builtin_cpu_supports("avx2"))
+	{
+		return east ? scan_east_avx2 : scan_west_avx2;
+	}
+	return 0;
+}
+
+static const wide_scan_fn wide_scan_east = select_wide_scan(true);
+static const wide_scan_fn wide_scan_west = select_wide_scan(false);
 
 warthog::jps::online_jump_point_locator2::online_jump_point_locator2(
-        warthog::gridmap* map) : map_(map)//, jumplimit_(UINT32_MAX)
+        warthog::gridmap* map) : map_(map), owns_rmap_(true)//, jumplimit_(UINT32_MAX)
+{
+	rmap_ = create_rmap(map);
+	current_node_id_ = current_rnode_id_ = warthog::INF32;
+	current_goal_id_ = current_rgoal_id_ = warthog::INF32;
+}
+
+warthog::jps::online_jump_point_locator2::online_jump_point_locator2(
+        warthog::gridmap* map, warthog::gridmap* rmap) 
+    : map_(map), rmap_(rmap), owns_rmap_(false)
 {
-	rmap_ = create_rmap();
 	current_node_id_ = current_rnode_id_ = warthog::INF32;
 	current_goal_id_ = current_rgoal_id_ = warthog::INF32;
 }
 
 warthog::jps::online_jump_point_locator2::~online_jump_point_locator2()
 {
-	delete rmap_;
+	if(owns_rmap_) { delete rmap_; }
 }
 
 // create a copy of the grid map which is rotated by 90 degrees clockwise.
 // this version will be used when jumping North or South. 
 warthog::gridmap*
-warthog::jps::online_jump_point_locator2::create_rmap()
+warthog::jps::online_jump_point_locator2::create_rmap(warthog::gridmap* map)
 {
-	uint32_t maph = map_->header_height();
-	uint32_t mapw = map_->header_width();
+	uint32_t maph = map->header_height();
+	uint32_t mapw = map->header_width();
 	uint32_t rmaph = mapw;
 	uint32_t rmapw = maph;
 	warthog::gridmap* rmap = new warthog::gridmap(rmaph, rmapw);
@@ -33,7 +194,7 @@ warthog::jps::online_jump_point_locator2::create_rmap()
 	{
 		for(uint32_t y = 0; y < maph; y++)
 		{
-			uint32_t label = map_->get_label(map_->to_padded_id(x, y));
+			uint32_t label = map->get_label(map->to_padded_id(x, y));
 			uint32_t rx = ((rmapw-1) - y);
 			uint32_t ry = x;
 			uint32_t rid = rmap->to_padded_id(rx, ry);
@@ -119,7 +280,7 @@ warthog::jps::online_jump_point_locator2::jump_north(
 	{
 		jumpnode_id = current_node_id_ - (uint32_t)(jumpcost) * map_->width();
 		jpoints.push_back(jumpnode_id);
-		costs.push_back(jumpcost);
+		costs.push_back(jumpcost * warthog::CARD_COST);
 	}
 }
 
@@ -149,7 +310,7 @@ warthog::jps::online_jump_point_locator2::jump_south(
 	{
 		jumpnode_id = current_node_id_ + (uint32_t)(jumpcost ) * map_->width();
 		jpoints.push_back(jumpnode_id);
-		costs.push_back(jumpcost);
+		costs.push_back(jumpcost * warthog::CARD_COST);
 	}
 }
 
@@ -178,7 +339,7 @@ warthog::jps::online_jump_point_locator2::jump_east(
 	if(jumpnode_id != warthog::INF32)
 	{
 		jpoints.push_back(jumpnode_id);
-		costs.push_back(jumpcost);
+		costs.push_back(jumpcost * warthog::CARD_COST);
 	}
 }
 
@@ -255,6 +416,20 @@ warthog::jps::online_jump_point_locator2::__jump_east(uint32_t node_id,
     // similarly to the above. but now the stride is a 
     // fixed 64bit and the jumps are word-aligned.
     jumpnode_id = node_id + 64 - bit_offset;
+
+    // on wide maps, skip ahead over long runs of open tiles
+    if(wide_scan_east && mymap->width() >= WIDE_SCAN_MIN_WIDTH)
+    {
+        const uint64_t* rows[3];
+        mymap->get_neighbours_64bit_ptr(jumpnode_id, rows);
+        uint32_t skipped = wide_scan_east(rows);
+        if(skipped)
+        {
+            jumpnode_id += skipped;
+            mymap->get_neighbours_64bit(jumpnode_id - 1, neis);
+        }
+    }
+
 	while(true)
 	{
         // we need to forced neighbours might occur across 
@@ -326,7 +501,7 @@ warthog::jps::online_jump_point_locator2::jump_west(
 	if(jumpnode_id != warthog::INF32)
 	{
 		jpoints.push_back(jumpnode_id);
-		costs.push_back(jumpcost);
+		costs.push_back(jumpcost * warthog::CARD_COST);
 	}
 }
 
@@ -404,6 +579,20 @@ warthog::jps::online_jump_point_locator2::__jump_west(uint32_t node_id,
     // similarly to the above. but now the stride is a 
     // fixed 64bit and the jumps are word-aligned.
     jumpnode_id = node_id - (bit_offset+1);
+
+    // on wide maps, skip ahead over long runs of open tiles
+    if(wide_scan_west && mymap->width() >= WIDE_SCAN_MIN_WIDTH)
+    {
+        const uint64_t* rows[3];
+        mymap->get_neighbours_64bit_ptr(jumpnode_id, rows);
+        uint32_t skipped = wide_scan_west(rows);
+        if(skipped)
+        {
+            jumpnode_id -= skipped;
+            mymap->get_neighbours_64bit(jumpnode_id + 1, neis);
+        }
+    }
+
 	while(true)
 	{
         // we need to forced neighbours might occur across 
@@ -495,14 +684,14 @@ warthog::jps::online_jump_point_locator2::jump_northeast(
 		{
 			jp1_id = node_id - (uint32_t)(jp1_cost ) * map_->width();
 			jpoints.push_back(jp1_id);
-			costs.push_back(cost_to_nodeid + jumpcost + jp1_cost);
+			costs.push_back(cost_to_nodeid + jumpcost + jp1_cost * warthog::CARD_COST);
 			if(jp2_cost == 0) { break; } // no corner cutting
 		}
 
 		if(jp2_id != warthog::INF32)
 		{
 			jpoints.push_back(jp2_id);
-			costs.push_back(cost_to_nodeid + jumpcost + jp2_cost);
+			costs.push_back(cost_to_nodeid + jumpcost + jp2_cost * warthog::CARD_COST);
 			if(jp1_cost == 0) { break; } // no corner cutting
 		}
 		node_id = jumpnode_id;
@@ -544,7 +733,7 @@ warthog::jps::online_jump_point_locator2::__jump_northeast(
 
 	}
 	jumpnode_id = node_id;
-	jumpcost = num_steps*warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps*warthog::DIAG_COST;
 }
 
 void
@@ -583,14 +772,14 @@ warthog::jps::online_jump_point_locator2::jump_northwest(
 		{
 			jp1_id = node_id - (uint32_t)(jp1_cost ) * map_->width();
 			jpoints.push_back(jp1_id);
-			costs.push_back(cost_to_nodeid + jumpcost + jp1_cost);
+			costs.push_back(cost_to_nodeid + jumpcost + jp1_cost * warthog::CARD_COST);
 			if(jp2_cost == 0) { break; } // no corner cutting
 		}
 
 		if(jp2_id != warthog::INF32)
 		{
 			jpoints.push_back(jp2_id);
-			costs.push_back(cost_to_nodeid + jumpcost + jp2_cost);
+			costs.push_back(cost_to_nodeid + jumpcost + jp2_cost * warthog::CARD_COST);
 			if(jp1_cost == 0) { break; } // no corner cutting
 		}
 		node_id = jumpnode_id;
@@ -632,7 +821,7 @@ warthog::jps::online_jump_point_locator2::__jump_northwest(
 		}
 	}
 	jumpnode_id = node_id;
-	jumpcost = num_steps*warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps*warthog::DIAG_COST;
 }
 
 void
@@ -671,14 +860,14 @@ warthog::jps::online_jump_point_locator2::jump_southeast(
 		{
 			jp1_id = node_id + (uint32_t)(jp1_cost ) * map_->width();
 			jpoints.push_back(jp1_id);
-			costs.push_back(cost_to_nodeid + jumpcost + jp1_cost);
+			costs.push_back(cost_to_nodeid + jumpcost + jp1_cost * warthog::CARD_COST);
 			if(jp2_cost == 0) { break; } // no corner cutting
 		}
 
 		if(jp2_id != warthog::INF32)
 		{
 			jpoints.push_back(jp2_id);
-			costs.push_back(cost_to_nodeid + jumpcost + jp2_cost);
+			costs.push_back(cost_to_nodeid + jumpcost + jp2_cost * warthog::CARD_COST);
 			if(jp1_cost == 0) { break; } // no corner cutting
 		}
 		node_id = jumpnode_id;
@@ -720,7 +909,7 @@ warthog::jps::online_jump_point_locator2::__jump_southeast(
 		}
 	}
 	jumpnode_id = node_id;
-	jumpcost = num_steps*warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps*warthog::DIAG_COST;
 }
 
 void
@@ -758,14 +947,14 @@ warthog::jps::online_jump_point_locator2::jump_southwest(
 		{
 			jp1_id = node_id + (uint32_t)(jp1_cost ) * map_->width();
 			jpoints.push_back(jp1_id);
-			costs.push_back(cost_to_nodeid + jumpcost + jp1_cost);
+			costs.push_back(cost_to_nodeid + jumpcost + jp1_cost * warthog::CARD_COST);
 			if(jp2_cost == 0) { break; }
 		}
 
 		if(jp2_id != warthog::INF32)
 		{
 			jpoints.push_back(jp2_id);
-			costs.push_back(cost_to_nodeid + jumpcost + jp2_cost);
+			costs.push_back(cost_to_nodeid + jumpcost + jp2_cost * warthog::CARD_COST);
 			if(jp1_cost == 0) { break; }
 		}
 		node_id = jumpnode_id;
@@ -805,5 +994,5 @@ warthog::jps::online_jump_point_locator2::__jump_southwest(
 		}
 	}
 	jumpnode_id = node_id;
-	jumpcost = num_steps*warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps*warthog::DIAG_COST;
 }
@@ -83,7 +83,7 @@ class bidirectional_expander //: public  expansion_policy
         }
 
         inline void
-        first(warthog::search_node*& ret, double& cost)
+        first(warthog::search_node*& ret, warthog::cost_t& cost)
         {
             for(it_ = begin_; it_ != end_; it_++)
             {
@@ -101,7 +101,7 @@ class bidirectional_expander //: public  expansion_policy
         }
 
         inline void
-        next(warthog::search_node*& ret, double& cost)
+        next(warthog::search_node*& ret, warthog::cost_t& cost)
         {
             for( ; it_ != end_; it_++)
             {
@@ -38,6 +38,28 @@ class expansion_policy
             //nodepool_->eclaim();
         }        
 
+        // called before the search with number @param search_number;
+        // lets the node pool apply the limits of ::set_pool_limits
+        inline void
+        reclaim(uint32_t search_number)
+        {
+            nodepool_->reclaim(search_number);
+        }
+
+        // bound the memory held by the node pool between searches
+        // (see warthog::mem::node_pool::set_limits)
+        inline void
+        set_pool_limits(size_t max_bytes, uint32_t max_idle)
+        {
+            nodepool_->set_limits(max_bytes, max_idle);
+        }
+
+        inline size_t
+        peak_mem()
+        {
+            return mem() - nodepool_->mem() + nodepool_->peak_mem();
+        }
+
 		inline void
 		reset()
 		{
@@ -46,14 +68,14 @@ class expansion_policy
 		}
 
 		inline void
-		first(warthog::search_node*& ret, double& cost)
+		first(warthog::search_node*& ret, warthog::cost_t& cost)
 		{
             current_ = 0;
             n(ret, cost);
 		}
 
 		inline void
-		n(warthog::search_node*& ret, double& cost)
+		n(warthog::search_node*& ret, warthog::cost_t& cost)
 		{
             if(current_ < neis_->size())
             {
@@ -71,7 +93,7 @@ class expansion_policy
         // NB: also adjust the current neighbour index such that the 
         // subsequent call to ::next will return the nth+1 neighbour.
         inline void
-        get_successor(uint32_t which, warthog::search_node*& ret, double& cost)
+        get_successor(uint32_t which, warthog::search_node*& ret, warthog::cost_t& cost)
         {
             if(which < neis_->size())
             {
@@ -86,7 +108,7 @@ class expansion_policy
         }
 
 		inline void
-		next(warthog::search_node*& ret, double& cost)
+		next(warthog::search_node*& ret, warthog::cost_t& cost)
 		{
             current_++;
             n(ret, cost);
@@ -175,7 +197,7 @@ class expansion_policy
 
     protected:
         inline void 
-        add_neighbour(warthog::search_node* nei, double cost)
+        add_neighbour(warthog::search_node* nei, warthog::cost_t cost)
         {
             neis_->push_back(neighbour_record(nei, cost));
             //std::cout << " neis_.size() == " << neis_->size() << std::endl;
@@ -189,13 +211,13 @@ class expansion_policy
 
         struct neighbour_record
         {
-            neighbour_record(warthog::search_node* node, double cost)
+            neighbour_record(warthog::search_node* node, warthog::cost_t cost)
             {
                 node_ = node;
                 cost_ = cost;
             }
             warthog::search_node* node_;
-            double cost_;
+            warthog::cost_t cost_;
         };
 
         warthog::mem::node_pool* nodepool_;
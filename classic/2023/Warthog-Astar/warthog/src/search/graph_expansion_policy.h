@@ -69,14 +69,14 @@ class graph_expansion_policy
         }
 
 		inline void
-		first(warthog::search_node*& ret, double& cost)
+		first(warthog::search_node*& ret, warthog::cost_t& cost)
 		{
             edge_index_ = UINT32_MAX;
             next(ret, cost);
 		}
 
 		inline void
-		n(warthog::search_node*& ret, double& cost)
+		n(warthog::search_node*& ret, warthog::cost_t& cost)
 		{
             if(edge_index_ < current_graph_node_->out_degree())
             {
@@ -97,7 +97,7 @@ class graph_expansion_policy
         // NB: also adjust the current neighbour index such that the 
         // subsequent call to ::next will return the nth+1 neighbour.
         inline void
-        get_successor(uint32_t which, warthog::search_node*& ret, double& cost)
+        get_successor(uint32_t which, warthog::search_node*& ret, warthog::cost_t& cost)
         {
             if(which < current_graph_node_->out_degree())
             {
@@ -115,7 +115,7 @@ class graph_expansion_policy
         }
 
 		inline void
-		next(warthog::search_node*& ret, double& cost)
+		next(warthog::search_node*& ret, warthog::cost_t& cost)
 		{
             assert(current_graph_node_);
             ret = 0;
@@ -191,6 +191,10 @@ class graph_expansion_policy
         size_t
         get_node_pool_size() { return node_pool_size_; } 
 
+        // every node is allocated up front; nothing to reclaim
+        void
+        reclaim(uint32_t) { }
+
         size_t
 		mem() 
         {
@@ -40,9 +40,26 @@ namespace warthog
     static const uint32_t INF32 = UINT32_MAX; // indicates uninitialised or undefined values 
     static const uint64_t INFTY = UINT64_MAX; // indicates uninitialised or undefined values 
 
+#ifdef WARTHOG_INTEGER_COSTS
+    // building with WARTHOG_INTEGER_COSTS selects fixed-point costs for
+    // the uniform-cost grid searches: a straight step costs CARD_COST
+    // and a diagonal step DIAG_COST, their ratio being within 1e-7 of
+    // sqrt(2) (as in the subgoal graph entries). sums are exact, so
+    // nodes with equal f-values compare equal and ties are broken on g
+    // alone. COST_MAX leaves headroom for adding an edge cost to it.
+    // the weighted and road domains still assume real-valued costs.
+    typedef int64_t cost_t;
+    static const cost_t COST_MAX = INT64_MAX / 2;
+    static const cost_t COST_MIN = 1;
+    static const cost_t CARD_COST = 2378;
+    static const cost_t DIAG_COST = 3363;
+#else
     typedef double cost_t;
     static const cost_t COST_MAX = DBL_MAX; 
     static const cost_t COST_MIN = DBL_MIN;
+    static const cost_t CARD_COST = DBL_ONE;
+    static const cost_t DIAG_COST = DBL_ROOT_TWO;
+#endif
 
 	// hashing constants
 	static const uint32_t FNV32_offset_basis = 2166136261;
@@ -0,0 +1,507 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Entry.h"
+#include <cpd/graph_oracle.h>
+#include <domains/gridmap.h>
+#include <domains/xy_graph.h>
+#include <jps/online_jump_point_locator2.h>
+#include <search/grid_first_move_search.h>
+#include <util/timer.h>
+
+// a reverse compressed path database (CPD) over the grid: for every
+// subgoal and every tile, the first move of an optimal path from the
+// tile to the subgoal, stored per subgoal as runs of columns with a
+// common move (see graph_oracle.h). columns are in DFS preorder of the
+// grid graph, which keeps nearby tiles in the same runs. a subgoal is a
+// tile next to the corner of an obstacle: a diagonal neighbour is
+// blocked but the two tiles beside it are not.
+//
+// every jump point JPS stops at is a subgoal, so a query from s to g
+// expands g once with the JPS2 jump point locator (s in place of the
+// goal) and walks the rows of the jump points it finds from s, one
+// table lookup per step. the walks take turns, the one with the least
+// octile bound on its cost first, until one arrives; the path is that
+// walk, then the diagonal-first jump back to g. when g is a subgoal,
+// its own row is walked.
+//
+// building it runs a Dijkstra search from every subgoal; rows are shared
+// out among all hardware threads.
+
+// the CPD file holds this header, then the oracle as written by
+// graph_oracle's operator<<
+struct CpdHeader
+{
+	char magic[8];
+	uint32_t width, height;
+	uint32_t num_nodes, version;
+	uint64_t map_checksum;
+};
+
+static const char CPD_MAGIC[8] = {'W', 'G', 'R', 'I', 'D', 'C', 'P', 'D'};
+// version 1 had a row per tile, from the tile to every other tile
+static const uint32_t CPD_VERSION = 2;
+
+typedef warthog::cpd::graph_oracle_base<warthog::cpd::REVERSE> reverse_oracle;
+
+// read-only map data. built once per map and shared by every search
+// context created for that map.
+struct WarthogMap
+{
+	warthog::gridmap map;
+	// the oracle's id of each tile, row by row; INF32 for obstacles.
+	// nodes are numbered in the same order by gridmap_to_xy_graph
+	std::vector<uint32_t> ids;
+	// the connected component of each node; queries across components
+	// have no path and are not walked
+	std::vector<uint32_t> component;
+	// the map rotated for the jump point locators of all contexts
+	std::unique_ptr<warthog::gridmap> rmap;
+	// rows by node id; empty except for subgoals
+	reverse_oracle cpd;
+
+	WarthogMap(const std::vector<bool>& bits, int width, int height, const std::string& filename) : map(bits.begin(), bits.end(), height, width)
+	{ Init(filename); }
+
+	// the map arrives packed, so it is copied a word at a time
+	WarthogMap(const GPPC::BitGrid& grid, const std::string& filename) : map(grid.bits, grid.stride, grid.height, grid.width)
+	{ Init(filename); }
+
+	void Init(const std::string& filename);
+	uint64_t MapChecksum();
+	void Build(const std::string& filename);
+	bool Load(const std::string& filename);
+	void Save(const std::string& filename);
+};
+
+// a walk from the start towards jump point jpoints[jp], which is tile
+// to (node target). it has reached tile here (node cur). g is the cost
+// of the walk so far plus the jump from the goal to the jump point, and
+// f adds the octile distance left.
+struct Probe
+{
+	warthog::cost_t f, g;
+	uint32_t jp, cur, target;
+	xyLoc here, to;
+
+	bool operator<(const Probe& other) const { return f > other.f; }
+};
+
+// per-thread search state
+struct WarthogAlg
+{
+	std::shared_ptr<WarthogMap> shared;
+	warthog::jps::online_jump_point_locator2 jpl;
+	// the jump points around the goal and a heap of walks towards them
+	std::vector<uint32_t> jpoints;
+	std::vector<warthog::cost_t> costs;
+	std::vector<Probe> probes;
+	// table lookups since the last GetSearchStats call
+	uint64_t lookups;
+
+	WarthogAlg(std::shared_ptr<WarthogMap> data) : shared(std::move(data)),
+		jpl(&shared->map, shared->rmap.get()), lookups(0)
+	{ }
+};
+
+// a tile with a blocked diagonal neighbour, given its legal @param moves:
+// both straight moves beside the diagonal are legal, but it is not
+static bool IsSubgoal(uint8_t moves)
+{
+	static const uint8_t BESIDE[4] = {0x5, 0x9, 0x6, 0xA};
+	for (uint32_t i = 4; i < 8; i++)
+		if ((moves & BESIDE[i - 4]) == BESIDE[i - 4] && !(moves & (1 << i)))
+			return true;
+	return false;
+}
+
+void WarthogMap::Init(const std::string& filename)
+{
+	const uint32_t width = map.header_width();
+	const uint32_t height = map.header_height();
+	ids.assign(static_cast<size_t>(width) * height, warthog::INF32);
+	uint32_t num_nodes = 0;
+	for (uint32_t i = 0; i < ids.size(); i++)
+		if (map.get_label(map.to_padded_id(i)))
+			ids[i] = num_nodes++;
+
+	// label components by flood fill over the legal moves
+	std::vector<uint8_t> moves;
+	warthog::grid_first_move_search::legal_moves(&map, moves);
+	component.assign(num_nodes, warthog::INF32);
+	std::vector<uint32_t> stack;
+	for (uint32_t i = 0; i < ids.size(); i++) {
+		if (ids[i] == warthog::INF32 || component[ids[i]] != warthog::INF32)
+			continue;
+		component[ids[i]] = ids[i];
+		stack.push_back(i);
+		while (!stack.empty()) {
+			uint32_t j = stack.back();
+			stack.pop_back();
+			int32_t x = j % width, y = j / width;
+			for (uint32_t m = moves[map.to_padded_id(j)]; m; m &= m - 1) {
+				uint32_t d = __builtin_ctz(m);
+				uint32_t k = (y + warthog::grid_first_move_search::dy(d)) * width +
+					x + warthog::grid_first_move_search::dx(d);
+				if (component[ids[k]] == warthog::INF32) {
+					component[ids[k]] = ids[i];
+					stack.push_back(k);
+				}
+			}
+		}
+	}
+
+	rmap.reset(warthog::jps::online_jump_point_locator2::create_rmap(&map));
+	if (!Load(filename))
+		Build(filename);
+}
+
+// fingerprint the obstacles so a CPD built for another version of the
+// same map is never used
+uint64_t WarthogMap::MapChecksum()
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for (uint32_t i = 0; i < ids.size(); i++)
+		hash = (hash ^ (ids[i] == warthog::INF32)) * 1099511628211ULL;
+	return hash;
+}
+
+void WarthogMap::Build(const std::string& filename)
+{
+	warthog::timer t;
+	t.start();
+	const uint32_t width = map.header_width();
+	const uint32_t num_nodes = static_cast<uint32_t>(component.size());
+
+	// the oracle is built over the xy_graph of the grid, which orders
+	// the columns; rows come from searches on the grid itself, with
+	// moves numbered as by grid_first_move_search
+	warthog::graph::xy_graph g;
+	warthog::graph::gridmap_to_xy_graph(&map, &g);
+	assert(g.get_num_nodes() == num_nodes);
+	cpd = reverse_oracle(&g);
+	cpd.compute_dfs_preorder();
+
+	// padded ids to node ids and back
+	std::vector<uint32_t> node_of(map.padded_mapsize(), warthog::INF32);
+	std::vector<uint32_t> tile_of(num_nodes);
+	for (uint32_t i = 0; i < ids.size(); i++) {
+		if (ids[i] == warthog::INF32)
+			continue;
+		uint32_t p = map.to_padded_id(i % width, i / width);
+		node_of[p] = ids[i];
+		tile_of[ids[i]] = p;
+	}
+
+	std::vector<uint8_t> moves;
+	warthog::grid_first_move_search::legal_moves(&map, moves);
+	std::vector<uint32_t> subgoals;
+	for (uint32_t n = 0; n < num_nodes; n++)
+		if (IsSubgoal(moves[tile_of[n]]))
+			subgoals.push_back(n);
+
+	// rows are independent and each is written by one thread only
+	std::atomic<uint32_t> next(0);
+	auto worker = [this, &moves, &node_of, &tile_of, &subgoals, &next, num_nodes]()
+	{
+		warthog::grid_first_move_search search(&map, moves);
+		std::vector<warthog::cpd::fm_coll> row(num_nodes);
+		for (uint32_t i; (i = next.fetch_add(1)) < subgoals.size(); ) {
+			uint32_t t = subgoals[i];
+			std::fill(row.begin(), row.end(), warthog::cpd::CPD_FM_NONE);
+			search.run_to(tile_of[t], [&row, &node_of](uint32_t u, uint8_t m) {
+				row[node_of[u]] = m;
+			});
+			cpd.add_row(t, row);
+		}
+	};
+	uint32_t nthreads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<std::thread> threads;
+	for (uint32_t i = 1; i < nthreads; i++)
+		threads.emplace_back(worker);
+	worker();
+	for (std::thread& th : threads)
+		th.join();
+
+	cpd.value_index_swap_array();
+	std::cerr << "built cpd; nodes=" << num_nodes << " subgoals="
+		<< subgoals.size() << " threads=" << nthreads
+		<< " mem=" << (cpd.mem() >> 20) << "MB time="
+		<< t.elapsed_time_sec() << "s" << std::endl;
+	Save(filename);
+	// the graph is only needed while building
+	cpd.set_graph(nullptr);
+}
+
+bool WarthogMap::Load(const std::string& filename)
+{
+	std::ifstream in(filename, std::ios::binary);
+	if (!in.good())
+		return false;
+
+	CpdHeader h;
+	in.read(reinterpret_cast<char*>(&h), sizeof(h));
+	if (!in.good() || memcmp(h.magic, CPD_MAGIC, sizeof(h.magic)) != 0 ||
+		h.version != CPD_VERSION || h.width != map.header_width() || h.height != map.header_height() ||
+		h.num_nodes != component.size() || h.map_checksum != MapChecksum()) {
+		std::cerr << "cpd file " << filename << " does not match the map; rebuilding" << std::endl;
+		return false;
+	}
+	// operator>> stops at the end of a truncated file without failing the
+	// stream and keeps the rows read so far
+	in >> cpd;
+	if (in.fail() || cpd.get_num_rows() != h.num_nodes) {
+		std::cerr << "cpd file " << filename << " is damaged; rebuilding" << std::endl;
+		cpd = reverse_oracle();
+		return false;
+	}
+	return true;
+}
+
+// written next to the target under a unique name and renamed, so that a
+// process loading the file concurrently never reads a partial one and
+// concurrent builds never write the same file. operator<< reads the
+// number of nodes from the graph, so this is done while it is set.
+void WarthogMap::Save(const std::string& filename)
+{
+	if (filename.empty())
+		return;
+	std::string tmpname = filename + ".XXXXXX";
+	int fd = mkstemp(&tmpname[0]);
+	if (fd == -1) {
+		std::cerr << "err; cannot write cpd to " << filename << std::endl;
+		return;
+	}
+	// mkstemp creates the file readable by its owner only
+	bool ok = fchmod(fd, 0644) == 0;
+	close(fd);
+	std::ofstream out(tmpname, std::ios::binary);
+	CpdHeader h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, CPD_MAGIC, sizeof(h.magic));
+	h.width = map.header_width();
+	h.height = map.header_height();
+	h.num_nodes = static_cast<uint32_t>(component.size());
+	h.version = CPD_VERSION;
+	h.map_checksum = MapChecksum();
+	out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+	out << cpd;
+	out.close();
+	if (!ok || out.fail() || std::rename(tmpname.c_str(), filename.c_str()) != 0) {
+		std::cerr << "err; cannot write cpd to " << filename << std::endl;
+		std::remove(tmpname.c_str());
+	}
+}
+
+// PrepareForSearch may be called once per search thread; every call for
+// the same map returns a new context on top of the same WarthogMap.
+// @param args: passed on to the WarthogMap constructor
+template <typename... Args>
+static std::shared_ptr<WarthogMap> GetSharedMap(const std::string& filename, const Args&... args)
+{
+	static std::mutex lock;
+	static std::map<std::string, std::weak_ptr<WarthogMap>> maps;
+	std::lock_guard<std::mutex> guard(lock);
+	std::shared_ptr<WarthogMap> data = maps[filename].lock();
+	if (!data) {
+		data = std::make_shared<WarthogMap>(args...);
+		maps[filename] = data;
+	}
+	return data;
+}
+
+void PreprocessMap(const std::vector<bool> &bits, int width, int height, const std::string& filename)
+{
+	WarthogMap data(bits, width, height, filename);
+}
+
+void PreprocessMap(const GPPC::BitGrid& grid, const std::string& filename)
+{
+	WarthogMap data(grid, filename);
+}
+
+void *PrepareForSearch(const std::vector<bool> &bits, int width, int height, const std::string& filename) {
+	return new WarthogAlg(GetSharedMap(filename, bits, width, height, filename));
+}
+
+void *PrepareForSearch(const GPPC::BitGrid& grid, const std::string& filename) {
+	return new WarthogAlg(GetSharedMap(filename, grid, filename));
+}
+
+static warthog::cost_t Octile(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+	uint32_t dx = std::abs(x1 - x2), dy = std::abs(y1 - y2);
+	return std::min(dx, dy) * warthog::DIAG_COST +
+		(std::max(dx, dy) - std::min(dx, dy)) * warthog::CARD_COST;
+}
+
+// follow the first moves from s to the subgoal with node id @param t
+// and add s, the tiles where the move changes and t to @param path.
+// false if the table does not belong to this map.
+static bool Walk(WarthogAlg* alg, xyLoc s, uint32_t t, std::vector<xyLoc>& path)
+{
+	WarthogMap& m = *alg->shared;
+	const uint32_t width = m.map.header_width();
+	uint32_t cur = m.ids[s.y * width + s.x];
+	xyLoc here = s;
+	path.push_back(s);
+	uint32_t last = warthog::cpd::CPD_FM_NONE;
+	while (cur != t) {
+		uint32_t move = m.cpd.get_move(cur, t);
+		alg->lookups++;
+		if (move >= 8)
+			return false;
+		if (last != warthog::cpd::CPD_FM_NONE && move != last)
+			path.push_back(here);
+		here.x += warthog::grid_first_move_search::dx(move);
+		here.y += warthog::grid_first_move_search::dy(move);
+		cur = m.ids[here.y * width + here.x];
+		last = move;
+	}
+	if (path.back().x != here.x || path.back().y != here.y)
+		path.push_back(here);
+	return true;
+}
+
+// the jump point around g through which s has the shortest path, or
+// INF32 if the table does not belong to this map. the walks from s
+// towards the jump points take turns, a step at a time, in order of
+// their lower bound, so that a walk stops as soon as it cannot win.
+static uint32_t BestJumpPoint(WarthogAlg* alg, xyLoc s)
+{
+	WarthogMap& m = *alg->shared;
+	const uint32_t width = m.map.header_width();
+	std::vector<Probe>& heap = alg->probes;
+	heap.clear();
+	uint32_t start = m.ids[s.y * width + s.x];
+	for (uint32_t i = 0; i < alg->jpoints.size(); i++) {
+		uint32_t x, y;
+		m.map.to_unpadded_xy(alg->jpoints[i], x, y);
+		xyLoc to = {static_cast<int16_t>(x), static_cast<int16_t>(y)};
+		heap.push_back({alg->costs[i] + Octile(x, y, s.x, s.y), alg->costs[i],
+			i, start, m.ids[y * width + x], s, to});
+	}
+	std::make_heap(heap.begin(), heap.end());
+
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end());
+		Probe& p = heap.back();
+		// a step along an optimal path to a jump point keeps f, so the
+		// walk goes on until it falls behind another
+		bool lost = false;
+		do {
+			if (p.cur == p.target)
+				return p.jp;
+			uint32_t move = m.cpd.get_move(p.cur, p.target);
+			alg->lookups++;
+			if (move >= 8) {
+				lost = true;
+				break;
+			}
+			p.here.x += warthog::grid_first_move_search::dx(move);
+			p.here.y += warthog::grid_first_move_search::dy(move);
+			p.cur = m.ids[p.here.y * width + p.here.x];
+			p.g += move < 4 ? warthog::CARD_COST : warthog::DIAG_COST;
+			p.f = p.g + Octile(p.to.x, p.to.y, p.here.x, p.here.y);
+		} while (heap.size() == 1 || p.f <= heap.front().f);
+		if (lost)
+			heap.pop_back();
+		else
+			std::push_heap(heap.begin(), heap.end());
+	}
+	return warthog::INF32;
+}
+
+bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path) {
+	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
+	WarthogMap& m = *alg->shared;
+
+	const uint32_t width = m.map.header_width();
+	uint32_t start = m.ids[s.y * width + s.x];
+	uint32_t goal = m.ids[g.y * width + g.x];
+	if (start == warthog::INF32 || goal == warthog::INF32 ||
+		m.component[start] != m.component[goal])
+		return true;
+
+	if (start == goal || !m.cpd.get_row(goal).empty()) {
+		if (!Walk(alg, s, goal, path))
+			path.clear();
+		return true;
+	}
+
+	// every jump point around g has a row, except s if it is reached
+	// directly; its walk is empty
+	alg->jpoints.clear();
+	alg->costs.clear();
+	uint32_t gp = m.map.to_padded_id(g.x, g.y);
+	uint32_t sp = m.map.to_padded_id(s.x, s.y);
+	for (uint32_t d = 0; d < 8; d++)
+		alg->jpl.jump(static_cast<warthog::jps::direction>(1 << d), gp, sp,
+			alg->jpoints, alg->costs);
+	uint32_t jp = BestJumpPoint(alg, s);
+	if (jp == warthog::INF32)
+		return true;
+	uint32_t x, y;
+	m.map.to_unpadded_xy(alg->jpoints[jp], x, y);
+	xyLoc via = {static_cast<int16_t>(x), static_cast<int16_t>(y)};
+	if (!Walk(alg, s, m.ids[y * width + x], path)) {
+		path.clear();
+		return true;
+	}
+
+	// the jump from g went diagonally first, then straight to the jump
+	// point; the corner is where they meet
+	int16_t diag = std::min(std::abs(via.x - g.x), std::abs(via.y - g.y));
+	xyLoc corner = g;
+	corner.x += via.x > g.x ? diag : -diag;
+	corner.y += via.y > g.y ? diag : -diag;
+	if ((corner.x != via.x || corner.y != via.y) && (corner.x != g.x || corner.y != g.y))
+		path.push_back(corner);
+	path.push_back(g);
+	return true;
+}
+
+void GetPaths(void *data, const std::vector<std::pair<xyLoc, xyLoc>> &queries, std::vector<std::vector<xyLoc>> &paths) {
+	paths.resize(queries.size());
+	for (size_t i = 0; i < queries.size(); i++) {
+		paths[i].clear();
+		GetPath(data, queries[i].first, queries[i].second, paths[i]);
+	}
+}
+
+// every table lookup counts as an expansion
+void GetSearchStats(void *data, uint64_t &expanded, uint64_t &generated) {
+	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
+	expanded += alg->lookups;
+	generated += alg->lookups;
+	alg->lookups = 0;
+}
+
+// contexts share only the read-only WarthogMap
+bool ThreadSafeSearch() { return true; }
+
+// the shared map goes with the last context using it
+void ReleaseSearch(void *data) {
+	delete static_cast<WarthogAlg*>(data);
+}
+
+size_t GetMemoryUsage(void *data) {
+	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
+	WarthogMap& m = *alg->shared;
+	return sizeof(WarthogAlg) + sizeof(WarthogMap) + m.map.mem() +
+		m.rmap->mem() +
+		sizeof(uint32_t) * (m.ids.capacity() + m.component.capacity()) +
+		m.cpd.mem();
+}
+
+std::string GetName() { return "Warthog-CPD"; }
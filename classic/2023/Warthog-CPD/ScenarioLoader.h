@@ -0,0 +1,97 @@
+/*
+Copyright (c) 2023 Grid-based Path Planning Competition and Contributors <https://gppc.search-conference.org/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef GPPC_SCENARIOLOADER_H
+#define GPPC_SCENARIOLOADER_H
+
+#include <vector>
+#include <cstring>
+#include <string>
+#include <memory>
+#include "GPPC.h"
+
+static const int kNoScaling = -1;
+
+/** 
+ * Experiments stored by the ScenarioLoader class. 
+ */
+class ScenarioLoader;
+
+class Experiment {
+public:
+	Experiment(int sx,int sy,int gx,int gy,int b, double d, std::string m)
+    :startx(sx),starty(sy),goalx(gx),goaly(gy),scaleX(kNoScaling),scaleY(kNoScaling),bucket(b),distance(d),map(std::make_shared<const std::string>(m)){}
+	Experiment(int sx,int sy,int gx,int gy,int sizeX, int sizeY,int b, double d, std::string m)
+    :startx(sx),starty(sy),goalx(gx),goaly(gy),scaleX(sizeX),scaleY(sizeY),bucket(b),distance(d),map(std::make_shared<const std::string>(m)){}
+	int GetStartX() const {return startx;}
+	int GetStartY() const {return starty;}
+	int GetGoalX() const {return goalx;}
+	int GetGoalY() const {return goaly;}
+	int GetBucket() const {return bucket;}
+	double GetDistance() const {return distance;}
+	void GetMapName(char* mymap) const {strcpy(mymap,map->c_str());}
+	const char *GetMapName() const { return map->c_str(); }
+	int GetXScale() const {return scaleX;}
+	int GetYScale() const {return scaleY;}
+	
+private:
+	friend class ScenarioLoader;
+	int startx, starty, goalx, goaly;
+	int scaleX;
+	int scaleY;
+	int bucket;
+	double distance;
+	// experiments loaded from the same file share one copy of each map name
+	std::shared_ptr<const std::string> map;
+
+	Experiment(int sx,int sy,int gx,int gy,int sizeX, int sizeY,int b, double d, std::shared_ptr<const std::string> m)
+    :startx(sx),starty(sy),goalx(gx),goaly(gy),scaleX(sizeX),scaleY(sizeY),bucket(b),distance(d),map(std::move(m)){}
+};
+
+/** A class which loads and stores scenarios from files.  
+ * Versions currently handled: 0.0 and 1.0 (includes scale). 
+ * The file is mapped into memory and parsed in place; rows only allocate
+ * when the experiments vector grows or a new map name appears.
+ */
+
+class ScenarioLoader{
+public:
+	ScenarioLoader() { scenName[0] = 0; }
+	ScenarioLoader(const char *);
+	void Save(const char *);
+	int GetNumExperiments(){return experiments.size();}
+	const char *GetScenarioName() { return scenName; }
+	const Experiment &GetNthExperiment(int which) const
+	{return experiments[which];}
+	void AddExperiment(Experiment which);
+private:
+	char scenName[1024];
+	std::vector<Experiment> experiments;
+};
+
+/** Loads an octile map; in @map, true is traversable and false an obstacle.
+ * Like ScenarioLoader, it parses the file in place after mapping it.
+ * If @packed is given, it also receives the map, transposed copy included.
+ */
+void LoadMap(const char *fname, std::vector<bool> &map, int &width, int &height, GPPC::PackedGrid *packed = nullptr);
+
+#endif // GPPC_SCENARIOLOADER_H
@@ -0,0 +1,6 @@
+#!/bin/bash
+idx_dir="index_data"
+
+mkdir -p ${idx_dir}
+# build exec
+make
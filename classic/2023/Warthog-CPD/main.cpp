@@ -0,0 +1,637 @@
+/*
+Copyright (c) 2023 Grid-based Path Planning Competition and Contributors <https://gppc.search-conference.org/>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ios>
+#include <numeric>
+#include <algorithm>
+#include <string>
+#include <unistd.h>
+#include <cmath>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <list>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#endif
+#include "ScenarioLoader.h"
+#include "Timer.h"
+#include "Entry.h"
+#include "validator/ValidatePath.hpp"
+
+std::string datafile, mapfile, scenfile, requestfile, flag;
+const std::string index_dir = "index_data";
+constexpr double PATH_FIRST_STEP_LENGTH = 20.0;
+std::vector<bool> mapData;
+GPPC::PackedGrid packedMap;
+int width, height;
+bool pre   = false;
+bool run   = false;
+bool check = false;
+bool bench = false;
+bool perf  = false;
+bool serve = false;
+std::atomic<bool> perf_active(false); // some worker could open its counters
+int threads = 1;
+int batch = 1;
+size_t budget = 0; // bytes of search data kept by -serve, 0: no limit
+
+double euclidean_dist(const xyLoc& a, const xyLoc& b) {
+  int dx = std::abs(b.x - a.x);
+  int dy = std::abs(b.y - a.y);
+  double res = std::sqrt(dx * dx + dy * dy);
+  return res;
+}
+
+double GetPathLength(const std::vector<xyLoc>& path)
+{
+  double len = 0;
+  for (int x = 0; x < (int)path.size()-1; x++)
+    len += euclidean_dist(path[x], path[x+1]);
+  return len;
+}
+
+// returns -1 if valid path, otherwise id of segment where invalidness was detetcted
+int ValidatePath(const std::vector<xyLoc>& thePath)
+{
+  return inx::ValidatePath(mapData, width, height, thePath);
+}
+
+// hardware counters of the calling thread, read around each GetPath call
+// when -perf is given. counters the kernel refuses to open (no PMU in a VM,
+// perf_event_paranoid, non-Linux hosts) read as zero.
+class PerfCounters {
+public:
+  static const int N = 3; // cycles, LLC misses, branch misses
+
+  PerfCounters(): leader(-1), open(0) {
+    for (int i = 0; i < N; i++) slot[i] = -1;
+#ifdef __linux__
+    const uint64_t config[N] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int i = 0; i < N; i++) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = config[i];
+      attr.read_format = PERF_FORMAT_GROUP;
+      attr.disabled = leader < 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0));
+      if (fd < 0) continue;
+      if (leader < 0) leader = fd;
+      fds[open] = fd;
+      slot[i] = open++;
+    }
+    if (leader >= 0) {
+      ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  ~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < open; i++) close(fds[i]);
+#endif
+  }
+
+  bool Ok() const { return leader >= 0; }
+
+  void Read(uint64_t v[N]) {
+    uint64_t buf[1 + N] = {0};
+#ifdef __linux__
+    if (leader < 0 || read(leader, buf, sizeof(buf)) < 0) buf[0] = 0;
+#endif
+    for (int i = 0; i < N; i++)
+      v[i] = slot[i] >= 0 && slot[i] < static_cast<int>(buf[0]) ? buf[1 + slot[i]] : 0;
+  }
+
+private:
+  int leader, open;
+  int fds[N];
+  int slot[N]; // position of each counter in the group, or -1
+};
+
+struct QueryResult {
+  std::vector<xyLoc> path;
+  Timer::duration tcost, tcost_first, max_step;
+  bool done;
+  // filled in -bench mode; search counts come from GetSearchStats
+  uint64_t expanded, generated;
+  uint64_t counters[PerfCounters::N];
+};
+
+// adds the search counts since the last call to res, if the entry keeps them
+void AddSearchStats(void* data, QueryResult& res) {
+  uint64_t expanded = 0, generated = 0;
+  if (GetSearchStats)
+    GetSearchStats(data, expanded, generated);
+  res.expanded += expanded;
+  res.generated += generated;
+}
+
+void RunQuery(void* data, xyLoc s, xyLoc g, QueryResult& res, PerfCounters* pc) {
+  Timer t;
+  typedef Timer::duration dur;
+  std::vector<xyLoc>& thePath = res.path;
+  thePath.clear();
+  res.expanded = res.generated = 0;
+  std::fill(res.counters, res.counters + PerfCounters::N, 0);
+  uint64_t before[PerfCounters::N], after[PerfCounters::N];
+  dur max_step = dur::zero(), tcost = dur::zero(), tcost_first = dur::zero();
+  bool done = false, done_first = false;
+  do {
+    if (pc) pc->Read(before);
+    t.StartTimer();
+    done = GetPath(data, s, g, thePath);
+    t.EndTimer();
+    if (pc) {
+      pc->Read(after);
+      for (int i = 0; i < PerfCounters::N; i++)
+        res.counters[i] += after[i] - before[i];
+    }
+    max_step = std::max(max_step, t.GetElapsedTime());
+    tcost += t.GetElapsedTime();
+    if (!done_first) {
+      tcost_first += t.GetElapsedTime();
+      done_first = GetPathLength(thePath) >= PATH_FIRST_STEP_LENGTH - 1e-6;
+    }
+  } while (!done);
+  if (bench)
+    AddSearchStats(data, res);
+  res.tcost = tcost;
+  res.tcost_first = tcost_first;
+  res.max_step = max_step;
+  res.done = done;
+}
+
+// runs queries [first, last) with a single GetPaths call; the time of the
+// call is shared evenly among the queries of the batch
+void RunBatch(void* data, const std::vector<xyLoc>& starts, const std::vector<xyLoc>& goals,
+              int first, int last, std::vector<QueryResult>& results, PerfCounters* pc) {
+  Timer t;
+  std::vector<std::pair<xyLoc, xyLoc>> queries;
+  std::vector<std::vector<xyLoc>> paths;
+  for (int x = first; x < last; x++)
+    queries.push_back(std::make_pair(starts[x], goals[x]));
+  uint64_t before[PerfCounters::N], after[PerfCounters::N];
+  if (pc) pc->Read(before);
+  t.StartTimer();
+  GetPaths(data, queries, paths);
+  t.EndTimer();
+  if (pc) pc->Read(after);
+  QueryResult total;
+  total.expanded = total.generated = 0;
+  if (bench)
+    AddSearchStats(data, total);
+  const int k = last - first;
+  Timer::duration tcost = t.GetElapsedTime() / k;
+  for (int x = first; x < last; x++) {
+    QueryResult& res = results[x];
+    res.path.swap(paths[x - first]);
+    res.tcost = res.tcost_first = res.max_step = tcost;
+    res.done = true;
+    res.expanded = total.expanded / k;
+    res.generated = total.generated / k;
+    for (int i = 0; i < PerfCounters::N; i++)
+      res.counters[i] = pc ? (after[i] - before[i]) / k : 0;
+  }
+}
+
+// runs queries [0, n) over the search contexts in data, one worker thread per context;
+// each worker pulls the next unclaimed query (or batch) so slow queries do not stall a whole shard
+void RunQueries(const std::vector<void*>& data, const std::vector<xyLoc>& starts,
+                const std::vector<xyLoc>& goals, std::vector<QueryResult>& results) {
+  int n = static_cast<int>(starts.size());
+  std::atomic<int> next(0);
+  auto worker = [&](void* ctx) {
+    // counters are per thread, so each worker opens its own
+    PerfCounters counters;
+    PerfCounters* pc = perf && counters.Ok() ? &counters : nullptr;
+    if (pc) perf_active = true;
+    if (batch > 1) {
+      for (int x = next.fetch_add(batch); x < n; x = next.fetch_add(batch))
+        RunBatch(ctx, starts, goals, x, std::min(x + batch, n), results, pc);
+      return;
+    }
+    for (int x = next++; x < n; x = next++)
+      RunQuery(ctx, starts[x], goals[x], results[x], pc);
+  };
+  if (data.size() == 1) {
+    worker(data[0]);
+    return;
+  }
+  std::vector<std::thread> pool;
+  for (void* ctx: data)
+    pool.emplace_back(worker, ctx);
+  for (auto& th: pool)
+    th.join();
+}
+
+// nearest-rank percentile of the sorted values v
+Timer::duration::rep Percentile(const std::vector<Timer::duration::rep>& v, double p) {
+  if (v.empty()) return 0;
+  size_t rank = static_cast<size_t>(std::ceil(p * v.size()));
+  return v[std::max<size_t>(rank, 1) - 1];
+}
+
+// writes bench.csv: latency percentiles of time_cost and mean search and
+// hardware counts per query, for each scenario bucket and for all queries
+void WriteBench(ScenarioLoader& scen, const std::vector<QueryResult>& results) {
+  int n = static_cast<int>(results.size());
+  std::vector<int> buckets;
+  for (int x = 0; x < n; x++)
+    buckets.push_back(scen.GetNthExperiment(x).GetBucket());
+  std::sort(buckets.begin(), buckets.end());
+  buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+  buckets.push_back(-1); // all queries
+
+  std::ofstream fout("bench.csv");
+  fout << "map,scen,bucket,queries,p50,p90,p99,p999,max,mean,"
+          "expanded,generated,cycles,llc_misses,branch_misses" << std::endl;
+  for (int b: buckets) {
+    std::vector<Timer::duration::rep> times;
+    double sum = 0, expanded = 0, generated = 0;
+    double counters[PerfCounters::N] = {0};
+    for (int x = 0; x < n; x++) {
+      if (b >= 0 && scen.GetNthExperiment(x).GetBucket() != b) continue;
+      const QueryResult& res = results[x];
+      times.push_back(res.tcost.count());
+      sum += res.tcost.count();
+      expanded += res.expanded;
+      generated += res.generated;
+      for (int i = 0; i < PerfCounters::N; i++)
+        counters[i] += res.counters[i];
+    }
+    double m = static_cast<double>(times.size());
+    std::sort(times.begin(), times.end());
+    fout << mapfile << "," << scenfile << ",";
+    if (b >= 0) fout << b;
+    else fout << "all";
+    fout << "," << times.size() << ","
+         << Percentile(times, 0.5) << "," << Percentile(times, 0.9) << ","
+         << Percentile(times, 0.99) << "," << Percentile(times, 0.999) << ","
+         << times.back() << std::fixed << std::setprecision(1) << ","
+         << sum / m << "," << expanded / m << "," << generated / m;
+    // blank rather than zero when no counters were read
+    for (int i = 0; i < PerfCounters::N; i++) {
+      fout << ",";
+      if (perf_active) fout << counters[i] / m;
+    }
+    fout << std::defaultfloat << std::endl;
+  }
+}
+
+// appends the columns of the last line of pmap -x (virtual size, resident
+// size, dirty size) and the peak resident size of the process, in kB, to
+// run.info
+void WriteMemoryInfo() {
+  long vm = 0, rss = 0, dirty = 0, hwm = 0;
+  std::ifstream status("/proc/self/status");
+  std::string key;
+  while (status >> key) {
+    if (key == "VmSize:") status >> vm;
+    else if (key == "VmRSS:") status >> rss;
+    else if (key == "VmHWM:") status >> hwm;
+    status.ignore(256, '\n');
+  }
+  // pmap counts both shared and private dirty pages
+  std::ifstream smaps("/proc/self/smaps_rollup");
+  while (smaps >> key) {
+    long kb = 0;
+    if (key == "Shared_Dirty:" || key == "Private_Dirty:") {
+      smaps >> kb;
+      dirty += kb;
+    }
+    smaps.ignore(256, '\n');
+  }
+  if (hwm == 0) {
+    // no procfs; ru_maxrss is in kB on Linux
+    rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0) hwm = ru.ru_maxrss;
+  }
+  std::ofstream fout("run.info", std::ios::app);
+  fout << "total kB " << vm << " " << rss << " " << dirty << " " << hwm << std::endl;
+}
+
+// resident set size of the process in bytes, or 0 without procfs
+size_t ResidentBytes() {
+  long pages = 0, rss = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> pages >> rss;
+  return static_cast<size_t>(rss) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+void RunExperiment(const std::vector<void*>& data) {
+  ScenarioLoader scen(scenfile.c_str());
+  int n = scen.GetNumExperiments();
+  std::vector<xyLoc> starts(n), goals(n);
+  for (int x = 0; x < n; x++)
+  {
+    const Experiment& e = scen.GetNthExperiment(x);
+    starts[x].x = e.GetStartX();
+    starts[x].y = e.GetStartY();
+    goals[x].x = e.GetGoalX();
+    goals[x].y = e.GetGoalY();
+  }
+
+  std::vector<QueryResult> results(n);
+  RunQueries(data, starts, goals, results);
+  if (bench)
+    WriteBench(scen, results);
+
+  std::string resultfile = "result.csv";
+  std::ofstream fout(resultfile);
+  const std::string header = "map,scen,experiment_id,path_size,path_length,ref_length,time_cost,20steps_cost,max_step_time";
+
+  fout << header << std::endl;
+  for (int x = 0; x < n; x++)
+  {
+    xyLoc s = starts[x], g = goals[x];
+    const std::vector<xyLoc>& thePath = results[x].path;
+    bool done = results[x].done;
+    double plen = done?GetPathLength(thePath): 0;
+    double ref_len = scen.GetNthExperiment(x).GetDistance();
+
+
+    fout << std::setprecision(9) << std::fixed;
+    fout << mapfile  << "," << scenfile       << ","
+         << x        << "," << thePath.size() << ","
+         << plen     << "," << ref_len        << ","
+         << results[x].tcost.count() << "," << results[x].tcost_first.count() << ","
+         << results[x].max_step.count() << std::endl;
+    
+    // do basic check and print to stderr if problem
+    for (int i = 0, ie = static_cast<int>(thePath.size()); i < ie; ++i) {
+      xyLoc pos = thePath[i];
+      if (pos.x < 0 || pos.x >= width || pos.y < 0 || pos.y >= height) {
+        std::fprintf(stderr, "Scenario %d point %d out-of-bounds (%d,%d)\n", x, i, static_cast<int>(pos.x), static_cast<int>(pos.y));
+      }
+      if (i+1 != ie) {
+        xyLoc pos2 = thePath[i+1];
+        xyLoc pos3 = pos2; pos3.x -= pos.x; pos3.y -= pos.y;
+        if ( !(pos3.x == 0 || pos3.y == 0 || std::abs(pos3.x) == std::abs(pos3.y)) ) {
+          std::fprintf(stderr, "Scenario %d segment %d must be cardinal or ordinal in direction (%d,%d)-(%d,%d)\n", x, i,
+            static_cast<int>(pos.x), static_cast<int>(pos.y), static_cast<int>(pos2.x), static_cast<int>(pos2.y));
+        }
+      }
+    }
+
+    if (check) {
+      std::printf("%d %d %d %d", s.x, s.y, g.x, g.y);
+      int validness = ValidatePath(thePath);
+      if (validness < 0) {
+        std::printf(" valid");
+      } else {
+        std::printf(" invalid-%d", validness);
+      }
+      std::printf(" %d", static_cast<int>(thePath.size()));
+      for (const auto& it: thePath) {
+        std::printf(" %d %d", it.x, it.y);
+      }
+      std::printf(" %.5f\n", plen);
+    }
+  }
+}
+
+void print_help(char **argv) {
+  std::printf("Invalid Arguments\nUsage %s <flag> <map> <scenario> [options]\n", argv[0]);
+  std::printf("      %s -serve <requests> [-budget <MB>]\n", argv[0]);
+  std::printf("Flags:\n");
+  std::printf("\t-full : Preprocess map and run scenario\n");
+  std::printf("\t-pre : Preprocess map\n");
+  std::printf("\t-run : Run scenario without preprocessing\n");
+  std::printf("\t-check: Run for validation\n");
+  std::printf("\t-bench : Run scenario and also write latency percentiles per bucket to bench.csv\n");
+  std::printf("\t-serve : Answer \"<map> <sx> <sy> <gx> <gy>\" lines from <requests> (- for stdin) on stdout,\n"
+              "\t         keeping the prepared maps in memory; maps must be preprocessed beforehand\n");
+  std::printf("Options:\n");
+  std::printf("\t-threads <n> : Run scenario on n worker threads, each with its own PrepareForSearch context;\n"
+              "\t               only for entries that define ThreadSafeSearch\n");
+  std::printf("\t-batch <k> : Pass k consecutive queries at a time to GetPaths; per-query times are the batch time divided by k\n");
+  std::printf("\t-perf : With -bench, count cycles, LLC misses and branch misses around each GetPath call\n");
+  std::printf("\t-budget <MB> : With -serve, release the least recently used maps when their search data exceeds MB\n");
+}
+
+bool parse_argv(int argc, char **argv) {
+  if (argc < 2) return false;
+  flag = std::string(argv[1]);
+  if (flag == "-full") pre = run = true;
+  else if (flag == "-pre") pre = true;
+  else if (flag == "-run") run = true;
+  else if (flag == "-check") run = check = true;
+  else if (flag == "-bench") run = bench = true;
+  else if (flag == "-serve") serve = true;
+  else return false;
+
+  if (argc < 3) return false;
+  if (serve) requestfile = std::string(argv[2]);
+  else mapfile = std::string(argv[2]);
+
+  // <scenario> is positional for every flag but -serve, as in the usage line;
+  // only the flags that run it need it to be there
+  if (!serve && argc >= 4) scenfile = std::string(argv[3]);
+  else if (run) return false;
+
+  for (int i = serve ? 3 : 4; i < argc; i++) {
+    std::string opt(argv[i]);
+    if (opt == "-threads" && i+1 < argc) {
+      threads = std::atoi(argv[++i]);
+      if (threads < 1) return false;
+    }
+    else if (opt == "-batch" && i+1 < argc) {
+      batch = std::atoi(argv[++i]);
+      if (batch < 1) return false;
+    }
+    else if (opt == "-perf") perf = true;
+    else if (opt == "-budget" && serve && i+1 < argc) {
+      double mb = std::atof(argv[++i]);
+      if (mb <= 0) return false;
+      budget = static_cast<size_t>(mb * 1024 * 1024);
+    }
+    else return false;
+  }
+  if (threads > 1 && !(ThreadSafeSearch && ThreadSafeSearch())) {
+    std::fprintf(stderr, "-threads needs an entry whose ThreadSafeSearch returns true\n");
+    return false;
+  }
+  return true;
+}
+
+std::string basename(const std::string& path) {
+  std::size_t l = path.find_last_of('/');
+  if (l == std::string::npos) l = 0;
+  else l += 1;
+  std::size_t r = path.find_last_of('.');
+  if (r == std::string::npos) r = path.size()-1;
+  return path.substr(l, r-l);
+}
+
+// a map kept by -serve: the loaded grid and the search data prepared on it
+struct ServedMap {
+  std::string file;
+  std::vector<bool> bits;
+  GPPC::PackedGrid packed;
+  int width, height;
+  void *data;
+  size_t bytes;
+};
+
+// -serve: answers queries on any number of maps from one process. each line of
+// the request file is "<map> <sx> <sy> <gx> <gy>" and is answered on out by a
+// line "<sx> <sy> <gx> <gy> <n> <x1> <y1> ... <xn> <yn> <length>". the search data
+// of the most recently used maps is kept while it fits in the budget; the least
+// recently used maps are released first, but the one being queried never is.
+int Serve(FILE *out) {
+  if (!ReleaseSearch) {
+    std::fprintf(stderr, "-serve needs an entry that defines ReleaseSearch\n");
+    return 1;
+  }
+  void *(*prepareBits)(const GPPC::BitGrid&, const std::string&) = PrepareForSearch;
+
+  std::ifstream fin;
+  if (requestfile != "-") {
+    fin.open(requestfile);
+    if (!fin) {
+      std::fprintf(stderr, "cannot open %s\n", requestfile.c_str());
+      return 1;
+    }
+  }
+  std::istream& in = requestfile == "-" ? std::cin : fin;
+
+  std::list<ServedMap> maps; // most recently used first
+  std::unordered_map<std::string, std::list<ServedMap>::iterator> index;
+  size_t total = 0;
+  std::string file;
+  int sx, sy, gx, gy;
+  std::vector<xyLoc> path;
+  while (in >> file >> sx >> sy >> gx >> gy) {
+    auto found = index.find(file);
+    if (found != index.end()) {
+      maps.splice(maps.begin(), maps, found->second);
+    } else {
+      size_t rss = ResidentBytes();
+      maps.emplace_front();
+      ServedMap& m = maps.front();
+      m.file = file;
+      LoadMap(file.c_str(), m.bits, m.width, m.height, prepareBits ? &m.packed : nullptr);
+      std::string data = index_dir + "/" + GetName() + "-" + basename(file);
+      m.data = prepareBits ? prepareBits(m.packed.Grid(), data)
+                           : PrepareForSearch(m.bits, m.width, m.height, data);
+      if (GetMemoryUsage)
+        m.bytes = GetMemoryUsage(m.data) + m.bits.capacity() / 8 + m.packed.Bytes();
+      else
+        m.bytes = std::max(ResidentBytes(), rss) - rss;
+      total += m.bytes;
+      index[file] = maps.begin();
+      while (budget > 0 && total > budget && maps.size() > 1) {
+        ServedMap& lru = maps.back();
+        ReleaseSearch(lru.data);
+        total -= lru.bytes;
+        index.erase(lru.file);
+        maps.pop_back();
+      }
+    }
+
+    ServedMap& m = maps.front();
+    path.clear();
+    if (sx >= 0 && sx < m.width && sy >= 0 && sy < m.height &&
+        gx >= 0 && gx < m.width && gy >= 0 && gy < m.height) {
+      xyLoc s, g;
+      s.x = static_cast<int16_t>(sx);
+      s.y = static_cast<int16_t>(sy);
+      g.x = static_cast<int16_t>(gx);
+      g.y = static_cast<int16_t>(gy);
+      while (!GetPath(m.data, s, g, path)) { }
+    }
+    std::fprintf(out, "%d %d %d %d %d", sx, sy, gx, gy, static_cast<int>(path.size()));
+    for (const auto& it: path)
+      std::fprintf(out, " %d %d", it.x, it.y);
+    std::fprintf(out, " %.5f\n", GetPathLength(path));
+    std::fflush(out);
+  }
+
+  for (ServedMap& m: maps)
+    ReleaseSearch(m.data);
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+
+  // -serve replies on the original stdout
+  int reply_fd = dup(STDOUT_FILENO);
+
+  // redirect stdout to file
+  std::freopen("run.stdout", "w", stdout);
+  std::freopen("run.stderr", "w", stderr);
+
+  if (!parse_argv(argc, argv)) {
+    print_help(argv);
+    return 1;
+  }
+
+  if (serve) {
+    FILE *out = reply_fd >= 0 ? fdopen(reply_fd, "w") : nullptr;
+    return Serve(out ? out : stdout);
+  }
+
+  // the BitGrid forms of the entry functions are optional, see Entry.h
+  void (*preprocessBits)(const GPPC::BitGrid&, const std::string&) = PreprocessMap;
+  void *(*prepareBits)(const GPPC::BitGrid&, const std::string&) = PrepareForSearch;
+
+  // in mapData, 1: traversable, 0: obstacle
+  LoadMap(mapfile.c_str(), mapData, width, height, preprocessBits || prepareBits ? &packedMap : nullptr);
+  datafile = index_dir + "/" + GetName() + "-" + basename(mapfile);
+
+  if (pre) {
+    if (preprocessBits)
+      preprocessBits(packedMap.Grid(), datafile);
+    else
+      PreprocessMap(mapData, width, height, datafile);
+  }
+  
+  if (!run)
+    return 0;
+
+  std::vector<void*> references;
+  for (int i = 0; i < threads; i++)
+    references.push_back(prepareBits ? prepareBits(packedMap.Grid(), datafile)
+                                     : PrepareForSearch(mapData, width, height, datafile));
+
+  std::ofstream("run.info", std::ios::trunc);
+  WriteMemoryInfo();
+  RunExperiment(references);
+  WriteMemoryInfo();
+  return 0;
+}
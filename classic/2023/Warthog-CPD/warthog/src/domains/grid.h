@@ -0,0 +1,37 @@
+#ifndef WARTHOG_GRID_H
+#define WARTHOG_GRID_H
+
+// domains/grid.h
+//
+// A place for grid-related curios
+//
+// @author: dharabor
+// @created: 2018-11-03
+//
+
+namespace warthog
+{
+
+namespace grid
+{
+
+typedef enum
+{
+	NONE = 0,
+	NORTH = 1,
+	SOUTH = 2,
+	EAST = 4,
+	WEST = 8,
+	NORTHEAST = 16,
+	NORTHWEST = 32, 
+	SOUTHEAST = 64,
+	SOUTHWEST = 128,
+    ALL = 255
+} direction;
+
+
+}
+
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "gridmap.h"
+
+#include <cassert>
+#include <cstring>
+
+warthog::gridmap::gridmap(unsigned int h, unsigned int w)
+	: header_(h, w, "octile")
+{	
+	this->init_db();
+}
+
+// reverses the order of the bits in a word
+static inline uint64_t
+reverse64(uint64_t v)
+{
+	v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+	v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+	v = ((v >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((v & 0x0F0F0F0F0F0F0F0Full) << 4);
+	return __builtin_bswap64(v);
+}
+
+warthog::gridmap::gridmap(const uint64_t* rows, uint32_t stride,
+		uint32_t h, uint32_t w, bool reverse)
+	: header_(h, w, "octile")
+{
+	this->init_db();
+	assert(stride >= dbwidth64_);
+
+	// db_ keeps tile x of a row in bit x of the row, as rows does; both
+	// are read as little-endian 64bit words (cf. get_neighbours_64bit)
+	uint64_t* db64 = (uint64_t*)db_;
+	num_traversable_ = 0;
+	for(uint32_t y = 0; y < h; y++)
+	{
+		const uint64_t* src = rows + (size_t)y * stride;
+		uint64_t* dst = db64 +
+			(size_t)(y + padded_rows_before_first_row_) * dbwidth64_;
+		if(!reverse)
+		{
+			memcpy(dst, src, dbwidth64_ * sizeof(uint64_t));
+		}
+		else
+		{
+			// word k of the reversed row is reverse64(src[stride-1-k]) and
+			// has tile x at bit x + shift
+			uint32_t shift = stride * 64 - w;
+			for(uint32_t i = 0; i < dbwidth64_; i++)
+			{
+				uint32_t k = (i * 64 + shift) >> 6;
+				uint32_t off = (i * 64 + shift) & 63;
+				uint64_t lo = k < stride ? reverse64(src[stride-1-k]) : 0;
+				uint64_t hi = k + 1 < stride ? reverse64(src[stride-2-k]) : 0;
+				dst[i] = off ? (lo >> off) | (hi << (64 - off)) : lo;
+			}
+		}
+		for(uint32_t i = 0; i < dbwidth64_; i++)
+		{
+			num_traversable_ += __builtin_popcountll(dst[i]);
+		}
+	}
+}
+
+warthog::gridmap::gridmap(const char* filename)
+{
+	strcpy(filename_, filename);
+	warthog::gm_parser parser(filename);
+	this->header_ = parser.get_header();
+
+	init_db();
+	// populate matrix
+    num_traversable_ = 0;
+	for(unsigned int i = 0; i < parser.get_num_tiles(); i++)
+	{
+		unsigned char c = parser.get_tile_at(i);
+		switch(c)
+		{
+			case 'S':
+			case 'W': 
+			case 'T':
+			case '@':
+			case 'O': // these terrain types are obstacles
+				this->set_label(to_padded_id(i), 0); 
+				assert(this->get_label(to_padded_id(i)) == 0);
+				break;
+			default: // everything else is traversable
+				this->set_label(to_padded_id(i), 1); 
+                num_traversable_++;
+				assert(this->get_label(to_padded_id(i)) == 1);
+				break;
+		}
+	}
+}
+
+warthog::gridmap::gridmap(const warthog::gridmap& other) : db_(nullptr)
+{
+	other.copy_to(*this);
+}
+warthog::gridmap::gridmap(warthog::gridmap&& other)
+{
+	header_ = other.header_;
+	db_ = other.db_;
+	other.db_ = nullptr;
+	dbwidth_ = other.dbwidth_;
+	dbwidth64_ = other.dbwidth64_;
+	dbheight_ = other.dbheight_;
+	db_size_ = other.db_size_;
+	padded_width_ = other.padded_width_;
+	padded_height_ = other.padded_height_;
+	padding_per_row_ = other.padding_per_row_;
+	padding_column_above_ = other.padding_column_above_;
+	padded_rows_before_first_row_ = other.padded_rows_before_first_row_;
+	padded_rows_after_last_row_ = other.padded_rows_after_last_row_;
+	max_id_ = other.max_id_;
+	num_traversable_ = other.num_traversable_;
+}
+
+void
+warthog::gridmap::init_db()
+{
+	// when storing the grid we pad the edges of the map with
+	// zeroes. this eliminates the need for bounds checking when
+	// fetching the neighbours of a node. 
+	this->padded_rows_before_first_row_ = 3;
+	this->padded_rows_after_last_row_ = 3;
+	this->padded_height_ = this->header_.height_ + 
+		padded_rows_after_last_row_ +
+		padded_rows_before_first_row_;
+
+	// calculate # of extra/redundant padding bits required,
+	// per row, to align map width with dbword size
+	this->padded_width_  = this->header_.width_ + 1;
+    if((padded_width_ % 64) != 0) 
+    {
+        padded_width_ = (this->header_.width_ / 64 + 1) * 64;
+    }
+	this->padding_per_row_ = this->padded_width_ - this->header_.width_;
+
+    this->dbheight_ = padded_height_;
+    this->dbwidth_ = padded_width_ >> warthog::LOG2_DBWORD_BITS;
+    this->dbwidth64_ = padded_width_ >> 6;
+	this->db_size_ = this->dbwidth_ * this->dbheight_;
+
+	// create a one dimensional dbword array to store the grid
+	this->db_ = new warthog::dbword[db_size_];
+	for(unsigned int i=0; i < db_size_; i++)
+	{
+		db_[i] = 0;
+	}
+
+	max_id_ = db_size_-1;
+}
+
+warthog::gridmap::~gridmap()
+{
+	delete [] db_;
+}
+
+void 
+warthog::gridmap::print(std::ostream& out)
+{
+	out << "printing padded map" << std::endl;
+	out << "-------------------" << std::endl;
+	out << "type "<< header_.type_ << std::endl;
+	out << "height "<< this->height() << std::endl;
+	out << "width "<< this->width() << std::endl;
+	out << "map" << std::endl;
+	for(unsigned int y=0; y < this->height(); y++)
+	{
+		for(unsigned int x=0; x < this->width(); x++)
+		{
+			warthog::dbword c = this->get_label(y*this->width()+x);
+			out << (c ? '.' : '@');
+		}
+		out << std::endl;
+	}	
+}
+
+void warthog::gridmap::copy_to(warthog::gridmap& to) const
+{
+	to.header_ = header_;
+	if (to.db_) {
+		delete[] to.db_;
+	}
+	if (db_) {
+		to.db_ = ::new warthog::dbword[db_size_];
+	} else {
+		to.db_ = nullptr;
+	}
+	std::memcpy(to.filename_, filename_, sizeof(filename_));
+	to.dbwidth_ = dbwidth_;
+	to.dbwidth64_ = dbwidth64_;
+	to.dbheight_ = dbheight_;
+	to.db_size_ = db_size_;
+	to.padded_width_ = padded_width_;
+	to.padded_height_ = padded_height_;
+	to.padding_per_row_ = padding_per_row_;
+	to.padding_column_above_ = padding_column_above_;
+	to.padded_rows_before_first_row_ = padded_rows_before_first_row_;
+	to.padded_rows_after_last_row_ = padded_rows_after_last_row_;
+	to.max_id_ = max_id_;
+	to.num_traversable_ = num_traversable_;
+}
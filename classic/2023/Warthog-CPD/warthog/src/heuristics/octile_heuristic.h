@@ -0,0 +1,93 @@
+#ifndef WARTHOG_OCTILE_HEURISTIC_H
+#define WARTHOG_OCTILE_HEURISTIC_H
+
+// octile_heuristic.h
+//
+// Analogue of Manhattan Heuristic but for 8C grids (cf. 4C).
+//
+// @author: dharabor
+// @created: 21/08/2012
+//
+
+#include "constants.h"
+#include "helpers.h"
+
+#include <cstdlib>
+
+namespace warthog
+{
+
+class octile_heuristic
+{
+	public:
+		octile_heuristic(uint32_t mapwidth, uint32_t mapheight)
+	    	: mapwidth_(mapwidth)
+        { set_hscale(1.0); }
+
+		~octile_heuristic() { }
+
+		inline warthog::cost_t
+		h(int32_t x, int32_t y, int32_t x2, int32_t y2)
+		{
+			int32_t dx = abs(x-x2);
+			int32_t dy = abs(y-y2);
+			warthog::cost_t d;
+			if(dx < dy)
+			{
+				d = dx * warthog::DIAG_COST + (dy - dx) * warthog::CARD_COST;
+			}
+			else
+			{
+				d = dy * warthog::DIAG_COST + (dx - dy) * warthog::CARD_COST;
+			}
+#ifdef WARTHOG_INTEGER_COSTS
+			return (d * hscale_) >> HSCALE_BITS;
+#else
+			return d * hscale_;
+#endif
+		}
+
+		inline warthog::cost_t
+		h(warthog::sn_id_t id, warthog::sn_id_t id2)
+		{
+			int32_t x, x2;
+			int32_t y, y2;
+			warthog::helpers::index_to_xy((uint32_t)id, mapwidth_, x, y);
+			warthog::helpers::index_to_xy((uint32_t)id2,mapwidth_, x2, y2);
+			return this->h(x, y, x2, y2);
+		}
+
+#ifdef WARTHOG_INTEGER_COSTS
+        // with integer costs hscale is kept in fixed point, so that
+        // scaling h costs no conversions
+        inline void
+        set_hscale(double hscale)
+        { hscale_ = (warthog::cost_t)(hscale * (1 << HSCALE_BITS)); }
+
+        inline double
+        get_hscale() { return (double)hscale_ / (1 << HSCALE_BITS); }
+#else
+        inline void
+        set_hscale(double hscale) { hscale_ = hscale; }
+
+        inline double
+        get_hscale() { return hscale_; }
+#endif
+
+        size_t
+        mem() { return sizeof(this); }
+
+	private:
+		unsigned int mapwidth_;
+#ifdef WARTHOG_INTEGER_COSTS
+        static const int HSCALE_BITS = 16;
+        warthog::cost_t hscale_;
+#else
+        double hscale_;
+#endif
+};
+
+}
+
+#endif
+
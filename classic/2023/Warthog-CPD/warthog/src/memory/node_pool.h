@@ -0,0 +1,117 @@
+#ifndef WARTHOG_NODE_POOL_H
+#define WARTHOG_NODE_POOL_H
+
+// memory/node_pool.h
+//
+// A memory pool of warthog::search_node objects.
+//
+// This implementation uses ragged two-dimensional array 
+// allocator. Memory for the pool is reserved but nodes
+// are allocated in blocks of size NBS.
+// If a node from a block needs to be geneated then the 
+// entire block is allocated at the same time. 
+// By default, once allocated, memory is not released again
+// until destruction. Long-running processes can bound the pool
+// with ::set_limits, in which case ::reclaim (called before each
+// search) recycles blocks which no recent search has used and
+// releases all memory when the pool grows beyond a given size.
+//
+// On the one hand, this approach stores successor nodes in 
+// close proximity to their parents. On the other hand, 
+// blocks which are adjacent spatially may not be located 
+// contiguously in memory.
+//
+// @author: dharabor
+// @created: 02/09/2012
+// @updated: 2018-11-01
+//
+
+#include "cpool.h"
+#include "search_node.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace warthog
+{
+
+namespace mem
+{
+
+namespace node_pool_ns
+{
+	static const uint64_t NBS = 8; // node block size; set this >= 8
+	static const uint64_t LOG2_NBS = 3;
+	static const uint64_t NBS_MASK = 7;
+}
+
+class node_pool
+{
+	public:
+        node_pool(size_t num_nodes);
+		~node_pool();
+
+		// return a warthog::search_node object corresponding to the given id.
+		// if the node has already been generated, return a pointer to the 
+		// previous instance; otherwise allocate memory for a new object.
+		warthog::search_node*
+		generate(sn_id_t node_id);
+
+        // return a pre-allocated pointer. if the corresponding node has not
+        // been allocated yet, return null
+        warthog::search_node*
+        get_ptr(sn_id_t node_id);
+
+        // bound the pool: blocks whose nodes were last used @param
+        // max_idle or more searches ago are recycled, and if the pool
+        // holds more than @param max_bytes every block is released.
+        // a value of 0 disables the corresponding limit.
+        // NB: limits are only applied between searches, so a single
+        // search may still grow the pool beyond max_bytes.
+        void
+        set_limits(size_t max_bytes, uint32_t max_idle);
+
+        // apply the limits of ::set_limits before the search with
+        // number @param search_number starts. nodes from earlier
+        // searches may be released, so pointers to them are invalid
+        // afterwards. search numbers must not decrease.
+        void
+        reclaim(uint32_t search_number);
+
+        // current footprint of the pool, in bytes
+		size_t
+		mem();
+
+        // largest footprint observed at the start of a search
+        size_t
+        peak_mem();
+
+	private:
+        void init(size_t nblocks);
+
+        bool
+        is_idle(warthog::search_node* block, uint32_t search_number);
+
+        void
+        release_all();
+
+		size_t num_blocks_;
+		warthog::search_node** blocks_;
+		warthog::mem::cpool* blockspool_;
+
+        // recycled blocks, reused before new memory is taken from the pool
+        std::vector<warthog::search_node*> free_blocks_;
+        size_t max_bytes_;
+        uint32_t max_idle_;
+        uint32_t last_sweep_;
+        size_t peak_bytes_;
+//        uint64_t* node_init_;
+//        uint64_t node_init_sz_;
+};
+
+}
+
+}
+
+#endif
+
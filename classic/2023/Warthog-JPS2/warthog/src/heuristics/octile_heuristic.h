@@ -21,24 +21,33 @@ class octile_heuristic
 {
 	public:
 		octile_heuristic(uint32_t mapwidth, uint32_t mapheight)
-	    	: mapwidth_(mapwidth), hscale_(1.0)
-        { }
+	    	: mapwidth_(mapwidth)
+        { set_hscale(1.0); }
 
 		~octile_heuristic() { }
 
-		inline double
+		inline warthog::cost_t
 		h(int32_t x, int32_t y, int32_t x2, int32_t y2)
 		{
 			int32_t dx = abs(x-x2);
 			int32_t dy = abs(y-y2);
+			warthog::cost_t d;
 			if(dx < dy)
 			{
-				return (dx * warthog::DBL_ROOT_TWO + (dy - dx)) * hscale_;
+				d = dx * warthog::DIAG_COST + (dy - dx) * warthog::CARD_COST;
 			}
-			return (dy * warthog::DBL_ROOT_TWO + (dx - dy)) * hscale_;
+			else
+			{
+				d = dy * warthog::DIAG_COST + (dx - dy) * warthog::CARD_COST;
+			}
+#ifdef WARTHOG_INTEGER_COSTS
+			return (d * hscale_) >> HSCALE_BITS;
+#else
+			return d * hscale_;
+#endif
 		}
 
-		inline double
+		inline warthog::cost_t
 		h(warthog::sn_id_t id, warthog::sn_id_t id2)
 		{
 			int32_t x, x2;
@@ -48,18 +57,34 @@ class octile_heuristic
 			return this->h(x, y, x2, y2);
 		}
 
+#ifdef WARTHOG_INTEGER_COSTS
+        // with integer costs hscale is kept in fixed point, so that
+        // scaling h costs no conversions
+        inline void
+        set_hscale(double hscale)
+        { hscale_ = (warthog::cost_t)(hscale * (1 << HSCALE_BITS)); }
+
+        inline double
+        get_hscale() { return (double)hscale_ / (1 << HSCALE_BITS); }
+#else
         inline void
         set_hscale(double hscale) { hscale_ = hscale; }
 
         inline double
         get_hscale() { return hscale_; }
+#endif
 
         size_t
         mem() { return sizeof(this); }
 
 	private:
 		unsigned int mapwidth_;
+#ifdef WARTHOG_INTEGER_COSTS
+        static const int HSCALE_BITS = 16;
+        warthog::cost_t hscale_;
+#else
         double hscale_;
+#endif
 };
 
 }
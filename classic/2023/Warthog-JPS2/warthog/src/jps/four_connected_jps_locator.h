@@ -26,7 +26,7 @@ class four_connected_jps_locator
 
 		void
 		jump(warthog::jps::direction d, uint32_t node_id, uint32_t goalid, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 
 		size_t 
 		mem()
@@ -37,35 +37,35 @@ class four_connected_jps_locator
 	//private:
 		void
 		jump_north(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_south(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_east(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_west(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 
 		// these versions can be passed a map parameter to
 		// use when jumping. they allow switching between
 		// map_ and rmap_ (a rotated counterpart).
 		void
 		__jump_east(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost, 
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost, 
 				warthog::gridmap* mymap);
 		void
 		__jump_west(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost, 
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost, 
 				warthog::gridmap* mymap);
 		void
 		__jump_north(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost,
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost,
 				warthog::gridmap* mymap);
 		void
 		__jump_south(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost, 
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost, 
 				warthog::gridmap* mymap);
 
 		warthog::gridmap* map_;
@@ -8,6 +8,15 @@ warthog::jps2_expansion_policy::jps2_expansion_policy(warthog::gridmap* map)
 	jp_ids_.reserve(100);
 }
 
+warthog::jps2_expansion_policy::jps2_expansion_policy(
+        warthog::gridmap* map, warthog::gridmap* rmap)
+    : expansion_policy(map->height() * map->width())
+{
+	map_ = map;
+	jpl_ = new warthog::jps::online_jump_point_locator2(map, rmap);
+	jp_ids_.reserve(100);
+}
+
 warthog::jps2_expansion_policy::~jps2_expansion_policy()
 {
 	delete jpl_;
@@ -41,7 +41,7 @@ warthog::jps4c_expansion_policy::expand(
 		warthog::jps::direction d = (warthog::jps::direction) (1 << i);
 		if(succ_dirs & d)
 		{
-			double jumpcost;
+			warthog::cost_t jumpcost;
 			uint32_t succ_id;
 			jpl_->jump(d, current_id, goal_id, succ_id, jumpcost);
 
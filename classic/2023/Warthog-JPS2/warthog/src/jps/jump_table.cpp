@@ -0,0 +1,274 @@
+#include "gridmap.h"
+#include "jump_table.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char JUMP_TABLE_MAGIC[8] = {'W', 'J', 'P', 'S', 'P', 'L', 'U', 'S'};
+
+// FNV-1a over 64bit words; the table is ~0.5GB on large maps, so hashing
+// a word at a time keeps validation well below the cost of reading it
+static uint64_t
+checksum(const void* data, size_t bytes, uint64_t hash = 14695981039346656037ULL)
+{
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	for(; bytes >= 8; p += 8, bytes -= 8)
+	{
+		uint64_t word;
+		memcpy(&word, p, 8);
+		hash = (hash ^ word) * 1099511628211ULL;
+	}
+	for(; bytes > 0; p++, bytes--)
+	{
+		hash = (hash ^ *p) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+// bytes from the start of the labels to the overflow entries
+static size_t
+overflow_offset(uint32_t num_labels)
+{
+	return (num_labels + 7) & ~(size_t)7;
+}
+
+warthog::jps::jump_table::jump_table()
+	: labels_(0), size_(0), overflow_(0), num_overflow_(0),
+	  mapping_(0), mapping_size_(0)
+{ }
+
+warthog::jps::jump_table::~jump_table()
+{
+	clear();
+}
+
+void
+warthog::jps::jump_table::clear()
+{
+	if(mapping_)
+	{
+		munmap(mapping_, mapping_size_);
+	}
+	std::vector<uint8_t>().swap(label_buf_);
+	std::vector<overflow>().swap(overflow_buf_);
+	labels_ = 0;
+	size_ = 0;
+	overflow_ = 0;
+	num_overflow_ = 0;
+	mapping_ = 0;
+	mapping_size_ = 0;
+}
+
+void
+warthog::jps::jump_table::assign(const std::vector<uint16_t>& labels)
+{
+	clear();
+	label_buf_.resize(labels.size());
+	for(uint32_t i = 0; i < labels.size(); i++)
+	{
+		uint16_t num_steps = labels[i] & 32767;
+		if(num_steps < STEP_ESCAPE)
+		{
+			label_buf_[i] = (uint8_t)(((labels[i] >> 8) & 128) | num_steps);
+		}
+		else
+		{
+			label_buf_[i] = STEP_ESCAPE;
+			overflow_buf_.push_back(overflow{i, labels[i], 0});
+		}
+	}
+	labels_ = label_buf_.data();
+	size_ = (uint32_t)label_buf_.size();
+	overflow_ = overflow_buf_.data();
+	num_overflow_ = (uint32_t)overflow_buf_.size();
+}
+
+uint16_t
+warthog::jps::jump_table::overflow_label(uint32_t index) const
+{
+	const overflow* end = overflow_ + num_overflow_;
+	const overflow* it = std::lower_bound(overflow_, end, index,
+			[](const overflow& o, uint32_t i) { return o.index_ < i; });
+	assert(it != end && it->index_ == index);
+	return it->label_;
+}
+
+uint64_t
+warthog::jps::jump_table::content_checksum() const
+{
+	uint64_t hash = checksum(labels_, sizeof(*labels_)*(size_t)size_);
+	return checksum(overflow_, sizeof(*overflow_)*(size_t)num_overflow_, hash);
+}
+
+void
+warthog::jps::jump_table::make_header(warthog::gridmap* map, header& h) const
+{
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic_, JUMP_TABLE_MAGIC, sizeof(h.magic_));
+	h.version_ = VERSION;
+	h.data_offset_ = DATA_OFFSET;
+	h.width_ = map->header_width();
+	h.height_ = map->header_height();
+	h.padded_width_ = map->width();
+	h.padded_height_ = map->height();
+	h.num_labels_ = 8*map->padded_mapsize();
+
+	// fingerprint the obstacles so a table built for another version
+	// of the same map is never used
+	uint64_t hash = checksum(&h.width_, 4*sizeof(uint32_t));
+	for(uint32_t y = 0; y < h.height_; y++)
+	{
+		uint64_t row = 0;
+		for(uint32_t x = 0; x < h.width_; x++)
+		{
+			row = (row << 1) | map->get_label(map->to_padded_id(x, y));
+			if((x & 63) == 63 || x+1 == h.width_)
+			{
+				hash = checksum(&row, sizeof(row), hash);
+				row = 0;
+			}
+		}
+	}
+	h.map_checksum_ = hash;
+}
+
+static uint64_t
+header_checksum(warthog::jps::jump_table::header h)
+{
+	h.header_checksum_ = 0;
+	return checksum(&h, sizeof(h));
+}
+
+bool
+warthog::jps::jump_table::load(const char* filename, warthog::gridmap* map)
+{
+	std::cerr << "loading "<<filename << "... ";
+	int fd = open(filename, O_RDONLY);
+	if(fd == -1)
+	{
+		std::cerr << "no dice. oh well. keep going.\n"<<std::endl;
+		return false;
+	}
+
+	struct stat st;
+	header h;
+	header expected;
+	make_header(map, expected);
+	if(fstat(fd, &st) != 0 ||
+		pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h) ||
+		memcmp(h.magic_, expected.magic_, sizeof(h.magic_)) != 0 ||
+		h.version_ != VERSION || h.data_offset_ != DATA_OFFSET ||
+		h.header_checksum_ != header_checksum(h))
+	{
+		std::cerr << "not a version "<<VERSION<<" jump table; rebuilding.\n"
+			<<std::endl;
+		close(fd);
+		return false;
+	}
+	if(h.width_ != expected.width_ || h.height_ != expected.height_ ||
+		h.padded_width_ != expected.padded_width_ ||
+		h.padded_height_ != expected.padded_height_ ||
+		h.num_labels_ != expected.num_labels_ ||
+		h.map_checksum_ != expected.map_checksum_)
+	{
+		std::cerr << "built for a different map; rebuilding.\n"<<std::endl;
+		close(fd);
+		return false;
+	}
+
+	size_t bytes = DATA_OFFSET + overflow_offset(h.num_labels_) +
+		sizeof(overflow)*(size_t)h.num_overflow_;
+	if((size_t)st.st_size != bytes)
+	{
+		std::cerr << "wrong size; rebuilding.\n"<<std::endl;
+		close(fd);
+		return false;
+	}
+
+	void* mem = mmap(0, bytes, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(mem == MAP_FAILED)
+	{
+		std::cerr << "mmap failed; rebuilding.\n"<<std::endl;
+		return false;
+	}
+
+	clear();
+	mapping_ = mem;
+	mapping_size_ = bytes;
+	labels_ = static_cast<const uint8_t*>(mem) + DATA_OFFSET;
+	size_ = h.num_labels_;
+	overflow_ = reinterpret_cast<const overflow*>(
+			labels_ + overflow_offset(size_));
+	num_overflow_ = h.num_overflow_;
+	std::cerr <<"#labels="<<size_<<" #overflow="<<num_overflow_<<std::endl;
+	return true;
+}
+
+bool
+warthog::jps::jump_table::save(const char* filename, warthog::gridmap* map) const
+{
+	std::cerr << "saving to file "<<filename<<"; nodes="<<size_
+		<<" overflow="<<num_overflow_<<std::endl;
+
+	header h;
+	make_header(map, h);
+	if(h.num_labels_ != size_)
+	{
+		std::cerr << "err; jump table does not match the map. "
+			<<"not saved.\n"<<std::endl;
+		return false;
+	}
+	h.num_overflow_ = num_overflow_;
+	h.label_checksum_ = content_checksum();
+	h.header_checksum_ = header_checksum(h);
+
+	// write next to the target under a unique name and rename, so that a
+	// process loading the table concurrently never maps a partially
+	// written file and concurrent writers never share a temporary file
+	std::string tmpname = std::string(filename) + ".XXXXXX";
+	int fd = mkstemp(&tmpname[0]);
+	FILE* f = fd == -1 ? NULL : fdopen(fd, "wb");
+	if(f == NULL)
+	{
+		if(fd != -1)
+		{
+			close(fd);
+			unlink(tmpname.c_str());
+		}
+		std::cerr << "err; cannot write jump table to file "
+			<<filename<<". oh well. try to keep going.\n"<<std::endl;
+		return false;
+	}
+
+	char page[DATA_OFFSET];
+	memset(page, 0, sizeof(page));
+	memcpy(page, &h, sizeof(h));
+	char zeros[8] = {0};
+	size_t padding = overflow_offset(size_) - size_;
+	bool ok = fwrite(page, sizeof(page), 1, f) == 1 &&
+		fwrite(labels_, sizeof(*labels_), size_, f) == size_ &&
+		fwrite(zeros, 1, padding, f) == padding &&
+		fwrite(overflow_, sizeof(*overflow_), num_overflow_, f) ==
+			num_overflow_;
+	// mkstemp creates the file readable by its owner only
+	ok = fchmod(fd, 0644) == 0 && ok;
+	ok = (fclose(f) == 0) && ok;
+	if(!ok || rename(tmpname.c_str(), filename) != 0)
+	{
+		std::cerr << "err; failed writing jump table to file "
+			<<filename<<". oh well. try to keep going.\n"<<std::endl;
+		remove(tmpname.c_str());
+		return false;
+	}
+	return true;
+}
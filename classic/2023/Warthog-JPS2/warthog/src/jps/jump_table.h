@@ -0,0 +1,149 @@
+#ifndef WARTHOG_JUMP_TABLE_H
+#define WARTHOG_JUMP_TABLE_H
+
+// jump_table.h
+//
+// Storage for the JPS+ jump labels (8 per padded grid cell) used by the
+// offline jump point locators. A label is a uint16: the lower 15 bits
+// count the steps to the next jump point and the leading bit marks a
+// jump into a dead-end.
+//
+// Most jumps are short, so labels are stored in a single byte: the
+// leading bit is the dead-end flag and the lower 7 bits are the step
+// count. Jumps of STEP_ESCAPE steps or more store STEP_ESCAPE instead
+// and keep their full label in a side table sorted by label index.
+// This halves the table and the cache lines touched per expansion.
+//
+// The table is either built in memory or mapped read-only from a .jps+
+// file, in which case every process that loads the same file shares
+// its pages through the page cache instead of holding a private copy.
+//
+// File format (little endian, version 3):
+//   [0, 4096)   jump_table::header, zero padded to one page
+//   [4096, ...) num_labels uint8 labels, zero padded to 8 bytes,
+//               then num_overflow jump_table::overflow entries
+//
+// A file is rejected (and the table rebuilt) if the magic or version
+// do not match, if it was built for a map with different dimensions
+// or obstacles, if it has the wrong size, or if the header checksum
+// fails. Loading reads only the header: the labels are paged in as the
+// search touches them, so their checksum is recorded but not verified.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace warthog
+{
+
+class gridmap;
+
+namespace jps
+{
+
+class jump_table
+{
+	public:
+		static const uint32_t VERSION = 3;
+		static const uint32_t DATA_OFFSET = 4096;
+		static const uint8_t STEP_ESCAPE = 127;
+
+		struct header
+		{
+			char magic_[8];
+			uint32_t version_;
+			uint32_t data_offset_;
+			uint32_t width_;
+			uint32_t height_;
+			uint32_t padded_width_;
+			uint32_t padded_height_;
+			uint32_t num_labels_;
+			uint32_t num_overflow_;
+			uint64_t map_checksum_;
+			uint64_t label_checksum_;
+			// of the header, with this field set to 0
+			uint64_t header_checksum_;
+		};
+
+		struct overflow
+		{
+			uint32_t index_;
+			uint16_t label_;
+			uint16_t padding_;
+		};
+
+		jump_table();
+		~jump_table();
+
+		// replace the contents of the table with @param labels
+		void
+		assign(const std::vector<uint16_t>& labels);
+
+		// map @param filename read-only; false if the file is missing
+		// or does not hold a valid table for @param map
+		bool
+		load(const char* filename, warthog::gridmap* map);
+
+		// write the table for @param map to @param filename
+		bool
+		save(const char* filename, warthog::gridmap* map) const;
+
+		// the full 16bit label at @param index
+		inline uint16_t
+		label(uint32_t index) const
+		{
+			uint8_t l = labels_[index];
+			if((l & STEP_ESCAPE) != STEP_ESCAPE)
+			{
+				return (uint16_t)(((l & 128) << 8) | (l & STEP_ESCAPE));
+			}
+			return overflow_label(index);
+		}
+
+		inline uint32_t
+		size() const { return size_; }
+
+		inline uint32_t
+		num_overflow() const { return num_overflow_; }
+
+		inline size_t
+		mem() const
+		{
+			return sizeof(*this) + sizeof(*labels_)*size_ +
+				sizeof(*overflow_)*num_overflow_;
+		}
+
+	private:
+		jump_table(const jump_table&) = delete;
+		jump_table& operator=(const jump_table&) = delete;
+
+		void
+		clear();
+
+		uint16_t
+		overflow_label(uint32_t index) const;
+
+		uint64_t
+		content_checksum() const;
+
+		void
+		make_header(warthog::gridmap* map, header& h) const;
+
+		const uint8_t* labels_;
+		uint32_t size_;
+		const overflow* overflow_;
+		uint32_t num_overflow_;
+
+		// backing storage: either owned buffers or a file mapping
+		std::vector<uint8_t> label_buf_;
+		std::vector<overflow> overflow_buf_;
+		void* mapping_;
+		size_t mapping_size_;
+};
+
+}
+
+}
+
+#endif
@@ -1,11 +1,14 @@
 #define __STDC_FORMAT_MACROS
 #include "gridmap.h"
-#include "online_jump_point_locator.h"
 #include "offline_jump_point_locator.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <inttypes.h>
+#include <iostream>
 #include <stdio.h>
+#include <thread>
 
 warthog::offline_jump_point_locator::offline_jump_point_locator(
 		warthog::gridmap* map) : map_(map)
@@ -18,65 +21,204 @@ warthog::offline_jump_point_locator::~offline_jump_point_locator()
 	delete [] db_;
 }
 
+namespace
+{
+
+// step from a tile in each direction; index i is direction 1 << i
+const int32_t step_x[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+const int32_t step_y[8] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+
+const uint16_t DEADEND = 32768;
+const uint16_t MAX_STEPS = 32767;
+
+// lines of tiles labelled together by one thread. east and west lines
+// are rows; the others are numbered by key = x - dx*dy*y, so that a band
+// of keys covers a contiguous run of tiles in every row.
+const int32_t BAND = 64;
+struct jump_band
+{
+	uint32_t dir;
+	int32_t first, last;
+};
+
 void
-warthog::offline_jump_point_locator::preproc()
+add_bands(warthog::gridmap* map, uint32_t dir, std::vector<jump_band>& bands)
 {
-	if(load(map_->filename())) { return; }
+	int32_t w = (int32_t)map->header_width();
+	int32_t h = (int32_t)map->header_height();
+	int32_t first = 0, last = h;
+	if(step_y[dir])
+	{
+		int32_t s = step_x[dir] * step_y[dir];
+		first = std::min(0, -s*(h-1));
+		last = std::max(w, w - s*(h-1));
+	}
+	for(int32_t i = first; i < last; i += BAND)
+	{
+		bands.push_back({dir, i, std::min(i + BAND, last)});
+	}
+}
 
-	dbsize_ = 8*map_->padded_mapsize();
-	db_ = new uint16_t[dbsize_];
-	for(uint32_t i=0; i < dbsize_; i++) db_[i] = 0;
+uint16_t
+next_step(uint16_t label)
+{
+	if((label & MAX_STEPS) == MAX_STEPS)
+	{
+		std::cerr << "label overflow; maximum jump distance exceeded. aborting\n";
+		exit(1);
+	}
+	return label + 1;
+}
 
-	warthog::online_jump_point_locator jpl(map_);
-	for(uint32_t y = 0; y < map_->header_height(); y++)
+// label tile @param id with the jump warthog::online_jump_point_locator
+// makes from it in direction 1 << dir. @param after holds the jump from
+// the next tile in that direction (for diagonals, counted from the first
+// step) and is updated for the previous tile.
+//
+// a straight jump from a traversable tile stops on the next tile if that
+// tile is an obstacle (a dead-end after 0 steps) or has a forced
+// neighbour (a jump point after 1 step); otherwise it is one step longer
+// than the jump from the next tile.
+//
+// a diagonal jump needs the tile, its two straight neighbours and the
+// diagonal neighbour to be traversable. it then steps diagonally until
+// either straight jump from the new tile finds a jump point, or one of
+// them is blocked straight away (a dead-end).
+inline void
+label_tile(warthog::gridmap* map, std::vector<uint16_t>& labels,
+		uint32_t dir, uint32_t id, uint16_t& after)
+{
+	const int32_t mapw = (int32_t)map->width();
+	const int32_t dx = step_x[dir];
+	const int32_t dy = step_y[dir];
+	const uint32_t next = id + dy*mapw + dx;
+	uint16_t label;
+	if(dx == 0 || dy == 0)
+	{
+		// the two tiles beside the line
+		const int32_t side = dx ? mapw : 1;
+		if(!map->get_label(id) || !map->get_label(next))
+		{
+			label = DEADEND;
+		}
+		else if((map->get_label(next + side) && !map->get_label(id + side)) ||
+			(map->get_label(next - side) && !map->get_label(id - side)))
+		{
+			label = 1;
+		}
+		else
+		{
+			label = next_step(after);
+		}
+		after = label;
+	}
+	else
 	{
-		for(uint32_t x = 0; x < map_->header_width(); x++)
+		uint16_t cont;
+		if(!map->get_label(next))
 		{
-			uint32_t mapid = map_->to_padded_id(x, y);
-//			std::cout << mapid << " ";
-			for(uint32_t i = 0; i < 8; i++)
+			cont = DEADEND | 1;
+		}
+		else
+		{
+			uint16_t vert = labels[8*next + (dy < 0 ? 0 : 1)];
+			uint16_t horiz = labels[8*next + (dx > 0 ? 2 : 3)];
+			if(!(vert & DEADEND) || !(horiz & DEADEND)) { cont = 1; }
+			else if(!(vert & MAX_STEPS) || !(horiz & MAX_STEPS)) { cont = DEADEND | 1; }
+			else { cont = next_step(after); }
+		}
+		after = cont;
+
+		bool first_step = map->get_label(id) && map->get_label(next) &&
+			map->get_label(id + dx) && map->get_label(id + dy*mapw);
+		label = first_step ? cont : DEADEND;
+	}
+	labels[8*id + dir] = label;
+}
+
+// label the lines of a band, sweeping each against the direction of
+// travel. bands crossing rows advance one row at a time so that every
+// row is read and written in one contiguous run.
+void
+sweep(warthog::gridmap* map, std::vector<uint16_t>& labels,
+		const jump_band& band)
+{
+	const int32_t dx = step_x[band.dir];
+	const int32_t dy = step_y[band.dir];
+	const int32_t w = (int32_t)map->header_width();
+	const int32_t h = (int32_t)map->header_height();
+
+	if(dy == 0)
+	{
+		for(int32_t y = band.first; y < band.last; y++)
+		{
+			uint16_t after = DEADEND;
+			int32_t x = dx > 0 ? w - 1 : 0;
+			for(uint32_t id = map->to_padded_id(x, y); x >= 0 && x < w;
+					x -= dx, id -= dx)
 			{
-				warthog::jps::direction dir = 
-					(warthog::jps::direction)(1 << i);
-//				std::cout << dir << ": ";
-				uint32_t jumpnode_id;
-				double jumpcost;
-				jpl.jump(dir, mapid,
-						warthog::INF32, jumpnode_id, jumpcost);
-				
-				// convert from cost to number of steps
-				if(dir > 8)
-				{
-					jumpcost = jumpcost / warthog::DBL_ROOT_TWO;
-				}
-				uint32_t num_steps = (uint16_t)floor((jumpcost + 0.5));
-//				std::cout << (jumpnode_id == warthog::INF ? 0 : num_steps) << " ";
+				label_tile(map, labels, band.dir, id, after);
+			}
+		}
+		return;
+	}
 
-				// set the leading bit if the jump leads to a dead-end
-				if(jumpnode_id == warthog::INF32)
-				{
-					db_[mapid*8 + i] |= 32768;
-				}
+	const int32_t s = dx * dy;
+	std::vector<uint16_t> after(band.last - band.first, DEADEND);
+	for(int32_t i = 0; i < h; i++)
+	{
+		int32_t y = dy > 0 ? h - 1 - i : i;
+		int32_t x = std::max(0, band.first + s*y);
+		int32_t end = std::min(w, band.last + s*y);
+		for(uint32_t id = map->to_padded_id(x, y); x < end; x++, id++)
+		{
+			label_tile(map, labels, band.dir, id, after[x - s*y - band.first]);
+		}
+	}
+}
 
-				// truncate jump cost so we can fit the label into a single byte
-				//if(num_steps > 32767)
-				//{
-				//	num_steps = 32767;
-				//	jumpnode_id = 0; 
-				//}
+}
 
-				db_[mapid*8 + i] |= num_steps;
+void
+warthog::offline_jump_point_locator::preproc()
+{
+	if(load(map_->filename())) { return; }
 
-				if(num_steps > 32768)
-				{
-					std::cerr << "label overflow; maximum jump distance exceeded. aborting\n";
-					exit(1);
-				}
-			}
-//			std::cout << std::endl;
+	std::vector<uint16_t> labels(8*map_->padded_mapsize(), 0);
+
+	// the jump from a tile follows in O(1) from the jump of the next tile
+	// in the same direction, so each line of tiles is labelled by a single
+	// sweep against the direction of travel. lines are independent and
+	// are shared out among threads in bands; diagonal jumps continue along
+	// straight ones, so the straight labels are complete before the
+	// diagonal pass.
+	for(uint32_t first = 0; first < 8; first += 4)
+	{
+		std::vector<jump_band> bands;
+		for(uint32_t i = first; i < first + 4; i++)
+		{
+			add_bands(map_, i, bands);
 		}
+
+		std::atomic<size_t> next(0);
+		auto worker = [this, &labels, &bands, &next]()
+		{
+			for(size_t j; (j = next.fetch_add(1)) < bands.size(); )
+			{
+				sweep(map_, labels, bands[j]);
+			}
+		};
+		uint32_t nthreads = std::max(1u, std::thread::hardware_concurrency());
+		std::vector<std::thread> threads;
+		for(uint32_t t = 1; t < nthreads; t++) { threads.emplace_back(worker); }
+		worker();
+		for(std::thread& t : threads) { t.join(); }
 	}
 
+	dbsize_ = labels.size();
+	db_ = new uint16_t[dbsize_];
+	std::copy(labels.begin(), labels.end(), db_);
+
 	save(map_->filename());
 }
 
@@ -129,7 +271,7 @@ warthog::offline_jump_point_locator::save(const char* filename)
 void
 warthog::offline_jump_point_locator::jump(warthog::jps::direction d, 
 		uint32_t node_id, uint32_t goal_id, uint32_t& jumpnode_id, 
-		double& jumpcost)
+		warthog::cost_t& jumpcost)
 {
 	current_ = max_ = 0;
 	switch(d)
@@ -165,7 +307,7 @@ warthog::offline_jump_point_locator::jump(warthog::jps::direction d,
 
 void
 warthog::offline_jump_point_locator::jump_northwest(uint32_t node_id,
-	  	uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+	  	uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	uint32_t mapw = map_->width();
 	uint16_t label = db_[8*node_id + 5];
@@ -193,7 +335,7 @@ warthog::offline_jump_point_locator::jump_northwest(uint32_t node_id,
 				if(jumpnode_id == goal_id)
 				{
 					jumpnode_id = goal_id;
-					jumpcost = steps_to_nid * warthog::DBL_ROOT_TWO + jumpcost;
+					jumpcost = steps_to_nid * warthog::DIAG_COST + jumpcost;
 					return;
 				}
 			}
@@ -205,7 +347,7 @@ warthog::offline_jump_point_locator::jump_northwest(uint32_t node_id,
 				if(jumpnode_id == goal_id)
 				{
 					jumpnode_id = goal_id;
-					jumpcost = steps_to_nid * warthog::DBL_ROOT_TWO + jumpcost;
+					jumpcost = steps_to_nid * warthog::DIAG_COST + jumpcost;
 					return;
 				}
 			}
@@ -214,13 +356,13 @@ warthog::offline_jump_point_locator::jump_northwest(uint32_t node_id,
 
 	// return the jump point; but only if it isn't sterile
 	jumpnode_id = node_id - id_delta;
-	jumpcost = num_steps * warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps * warthog::DIAG_COST;
 	if(label & 32768) { jumpnode_id = warthog::INF32; }
 }
 
 void
 warthog::offline_jump_point_locator::jump_northeast(uint32_t node_id,
-	  	uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+	  	uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	uint16_t label = db_[8*node_id + 4];
 	uint16_t num_steps = label & 32767;
@@ -248,7 +390,7 @@ warthog::offline_jump_point_locator::jump_northeast(uint32_t node_id,
 				if(jumpnode_id == goal_id)
 				{
 					jumpnode_id = goal_id;
-					jumpcost = steps_to_nid * warthog::DBL_ROOT_TWO + jumpcost;
+					jumpcost = steps_to_nid * warthog::DIAG_COST + jumpcost;
 					return;
 				}
 			}
@@ -260,7 +402,7 @@ warthog::offline_jump_point_locator::jump_northeast(uint32_t node_id,
 				if(jumpnode_id == goal_id)
 				{
 					jumpnode_id = goal_id;
-					jumpcost = steps_to_nid * warthog::DBL_ROOT_TWO + jumpcost;
+					jumpcost = steps_to_nid * warthog::DIAG_COST + jumpcost;
 					return;
 				}
 			}
@@ -269,13 +411,13 @@ warthog::offline_jump_point_locator::jump_northeast(uint32_t node_id,
 
 	// return the jump point; but only if it isn't sterile
 	jumpnode_id = node_id - id_delta;
-	jumpcost = num_steps * warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps * warthog::DIAG_COST;
 	if(label & 32768) { jumpnode_id = warthog::INF32; }
 }
 
 void
 warthog::offline_jump_point_locator::jump_southwest(uint32_t node_id,
-	  	uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+	  	uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	uint16_t label = db_[8*node_id + 7];
 	uint16_t num_steps = label & 32767;
@@ -303,7 +445,7 @@ warthog::offline_jump_point_locator::jump_southwest(uint32_t node_id,
 				if(jumpnode_id == goal_id)
 				{ 
 					jumpnode_id = goal_id;
-					jumpcost = steps_to_nid * warthog::DBL_ROOT_TWO + jumpcost;
+					jumpcost = steps_to_nid * warthog::DIAG_COST + jumpcost;
 					return; 
 				}
 			}
@@ -315,7 +457,7 @@ warthog::offline_jump_point_locator::jump_southwest(uint32_t node_id,
 				if(jumpnode_id == goal_id)
 				{ 
 					jumpnode_id = goal_id;
-					jumpcost = steps_to_nid * warthog::DBL_ROOT_TWO + jumpcost;
+					jumpcost = steps_to_nid * warthog::DIAG_COST + jumpcost;
 					return; 
 				}
 			}
@@ -325,13 +467,13 @@ warthog::offline_jump_point_locator::jump_southwest(uint32_t node_id,
 
 	// return the jump point; but only if it isn't sterile
 	jumpnode_id = node_id + (mapw - 1) * num_steps;
-	jumpcost = num_steps * warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps * warthog::DIAG_COST;
 	if(label & 32768) { jumpnode_id = warthog::INF32; }
 }
 
 void
 warthog::offline_jump_point_locator::jump_southeast(uint32_t node_id,
-	  	uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+	  	uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	uint16_t label = db_[8*node_id + 6];
 	uint16_t num_steps = label & 32767;
@@ -358,7 +500,7 @@ warthog::offline_jump_point_locator::jump_southeast(uint32_t node_id,
 				if(jumpnode_id == goal_id)
 				{ 
 					jumpnode_id = goal_id;
-					jumpcost = steps_to_nid * warthog::DBL_ROOT_TWO + jumpcost;
+					jumpcost = steps_to_nid * warthog::DIAG_COST + jumpcost;
 					return; 
 				}
 			}
@@ -370,7 +512,7 @@ warthog::offline_jump_point_locator::jump_southeast(uint32_t node_id,
 				if(jumpnode_id == goal_id)
 				{ 
 					jumpnode_id = goal_id;
-					jumpcost = steps_to_nid * warthog::DBL_ROOT_TWO + jumpcost;
+					jumpcost = steps_to_nid * warthog::DIAG_COST + jumpcost;
 					return; 
 				}
 			}
@@ -379,13 +521,13 @@ warthog::offline_jump_point_locator::jump_southeast(uint32_t node_id,
 
 
 	jumpnode_id = node_id + (mapw + 1) * num_steps;
-	jumpcost = num_steps * warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps * warthog::DIAG_COST;
 	if(label & 32768) { jumpnode_id = warthog::INF32; }
 }
 
 void
 warthog::offline_jump_point_locator::jump_north(uint32_t node_id,
-	  	uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+	  	uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	uint16_t label = db_[8*node_id];
 	uint16_t num_steps = label & 32767;
@@ -400,20 +542,20 @@ warthog::offline_jump_point_locator::jump_north(uint32_t node_id,
 		if(nx == gx) 
 		{ 
 			jumpnode_id = goal_id; 
-			jumpcost = (goal_delta / map_->width());
+			jumpcost = (goal_delta / map_->width()) * warthog::CARD_COST;
 			return;
 		}
 	}
 
 	// return the jump point at hand
 	jumpnode_id = node_id - id_delta;
-	jumpcost = num_steps;
+	jumpcost = num_steps * warthog::CARD_COST;
 	if(label & 32768) { jumpnode_id = warthog::INF32; }
 }
 
 void
 warthog::offline_jump_point_locator::jump_south(uint32_t node_id,
-	  	uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+	  	uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	uint16_t label = db_[8*node_id + 1];
 	uint16_t num_steps = label & 32767;
@@ -428,20 +570,20 @@ warthog::offline_jump_point_locator::jump_south(uint32_t node_id,
 		if(nx == gx) 
 		{ 
 			jumpnode_id = goal_id; 
-			jumpcost = goal_delta / map_->width();
+			jumpcost = (goal_delta / map_->width()) * warthog::CARD_COST;
 			return;
 		}
 	}
 
 	// return the jump point at hand
 	jumpnode_id = node_id + id_delta;
-	jumpcost = num_steps;
+	jumpcost = num_steps * warthog::CARD_COST;
  	if(label & 32768) { jumpnode_id = warthog::INF32; }
 }
 
 void
 warthog::offline_jump_point_locator::jump_east(uint32_t node_id,
-	  	uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+	  	uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	uint16_t label = db_[8*node_id + 2];
 
@@ -451,19 +593,19 @@ warthog::offline_jump_point_locator::jump_east(uint32_t node_id,
 	if(id_delta >= goal_delta)
 	{
 		jumpnode_id = goal_id;
-		jumpcost = goal_delta;
+		jumpcost = goal_delta * warthog::CARD_COST;
 		return;
 	}
 
 	// return the jump point at hand
 	jumpnode_id = node_id + id_delta;
-	jumpcost = id_delta;
+	jumpcost = id_delta * warthog::CARD_COST;
 	if(label & 32768) { jumpnode_id = warthog::INF32; }
 }
 
 void
 warthog::offline_jump_point_locator::jump_west(uint32_t node_id,
-	  	uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
+	  	uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	uint16_t label = db_[8*node_id + 3];
 
@@ -473,13 +615,13 @@ warthog::offline_jump_point_locator::jump_west(uint32_t node_id,
 	if(id_delta >= goal_delta)
 	{
 		jumpnode_id = goal_id;
-		jumpcost = goal_delta;
+		jumpcost = goal_delta * warthog::CARD_COST;
 		return;
 	}
 
 	// return the jump point at hand
 	jumpnode_id = node_id - id_delta;
-	jumpcost = id_delta;
+	jumpcost = id_delta * warthog::CARD_COST;
 	if(label & 32768) { jumpnode_id = warthog::INF32; }
 }
 
@@ -19,6 +19,19 @@ class problem_instance_base
 
         { }
 
+        // as above, but with the search number taken from the caller
+        // rather than from the shared instance counter. this lets each
+        // search context number its own queries, so several contexts
+        // can run concurrently without touching any global state.
+        problem_instance_base(STATE start, STATE target,
+                uint32_t instance_id, bool verbose) :
+            start_(start), 
+            target_(target), 
+            instance_id_(instance_id),
+            verbose_(verbose),
+            extra_params_(0)
+        { }
+
 		problem_instance_base(const warthog::problem_instance_base<STATE>&other)
         {
             this->start_ = other.start_;
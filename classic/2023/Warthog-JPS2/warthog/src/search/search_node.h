@@ -3,6 +3,16 @@
 
 // search_node.h
 //
+// Building with WARTHOG_COMPACT_SEARCH_NODE selects a 32 byte layout
+// (down from 56) for engines on grids and other small domains:
+//  - ids and parent ids are stored in 32 bits, so every state id
+//    (and padded grid id) must be below UINT32_MAX;
+//  - the expanded flag is packed into the high bit of the priority,
+//    so priorities must be below 2^31;
+//  - there is no upper bound field: get_ub always returns COST_MAX,
+//    so searches which track upper bounds (cpd_search) need the
+//    default layout.
+//
 // @author: dharabor
 // @created: 10/08/2012
 //
@@ -11,6 +21,7 @@
 #include "cpool.h"
 #include "jps.h"
 
+#include <atomic>
 #include <iostream>
 
 namespace warthog
@@ -19,6 +30,15 @@ namespace warthog
 class search_node
 {
 	public:
+#ifdef WARTHOG_COMPACT_SEARCH_NODE
+		search_node(warthog::sn_id_t id = warthog::SN_ID_MAX) :
+            id_(pack_id(id)), parent_id_(UINT32_MAX),
+            g_(warthog::COST_MAX), f_(warthog::COST_MAX),
+            priority_(PRIORITY_MASK), search_number_(UINT32_MAX)
+		{
+			refcount_++;
+		}
+#else
 		search_node(warthog::sn_id_t id = warthog::SN_ID_MAX) :
             id_(id), parent_id_(warthog::SN_ID_MAX),
             g_(warthog::COST_MAX), f_(warthog::COST_MAX), ub_(warthog::COST_MAX),
@@ -26,6 +46,7 @@ class search_node
 		{
 			refcount_++;
 		}
+#endif
 
 		~search_node()
 		{ refcount_--; }
@@ -37,12 +58,12 @@ class search_node
              warthog::cost_t f,
              warthog::cost_t ub=warthog::COST_MAX)
 		{
-            parent_id_= parent_id;
+            set_parent(parent_id);
             f_ = f;
             g_ = g;
-            ub_ = ub;
+            set_ub(ub);
 			search_number_ = search_number;
-            status_ = false;
+            set_expanded(false);
 		}
 
 		inline uint32_t
@@ -53,6 +74,39 @@ class search_node
         set_search_number(uint32_t search_number)
         { search_number_ = search_number; }
 
+#ifdef WARTHOG_COMPACT_SEARCH_NODE
+		inline warthog::sn_id_t
+		get_id() const 
+        { return unpack_id(id_); }
+
+		inline void
+		set_id(warthog::sn_id_t id)
+		{ id_ = pack_id(id); }
+
+		inline bool
+		get_expanded() const 
+        { return priority_ & EXPANDED_BIT; }
+
+		inline void
+		set_expanded(bool expanded)
+		{ priority_ = (priority_ & PRIORITY_MASK) | (expanded ? EXPANDED_BIT : 0); }
+
+		inline warthog::sn_id_t
+		get_parent() const 
+        { return unpack_id(parent_id_); }
+
+		inline void
+		set_parent(warthog::sn_id_t parent_id) { parent_id_ = pack_id(parent_id); }
+
+		// NB: INF32 reads back as PRIORITY_MASK
+		inline uint32_t
+		get_priority() const 
+        { return priority_ & PRIORITY_MASK; }
+
+		inline void
+		set_priority(uint32_t priority)
+		{ priority_ = (priority_ & EXPANDED_BIT) | (priority & PRIORITY_MASK); }
+#else
 		inline warthog::sn_id_t
 		get_id() const 
         { return id_; }
@@ -82,6 +136,7 @@ class search_node
 
 		inline void
 		set_priority(uint32_t priority) { priority_ = priority; }
+#endif
 
 		inline warthog::cost_t
 		get_g() const { return g_; }
@@ -95,11 +150,19 @@ class search_node
 		inline void
 		set_f(warthog::cost_t f) { f_ = f; }
 
+#ifdef WARTHOG_COMPACT_SEARCH_NODE
+		inline warthog::cost_t
+		get_ub() const { return warthog::COST_MAX; }
+
+		inline void
+		set_ub(warthog::cost_t ub) { assert(ub == warthog::COST_MAX); (void)ub; }
+#else
 		inline warthog::cost_t
 		get_ub() const { return ub_; }
 
 		inline void
 		set_ub(warthog::cost_t ub) { ub_ = ub; }
+#endif
 
 		inline void
 		relax(warthog::cost_t g, warthog::sn_id_t parent_id)
@@ -107,8 +170,10 @@ class search_node
 			assert(g < g_);
 			f_ = (f_ - g_) + g;
 			g_ = g;
+#ifndef WARTHOG_COMPACT_SEARCH_NODE
 			if (ub_ < warthog::COST_MAX) { ub_ = (ub_ - g_) + g; }
-			parent_id_ = parent_id;
+#endif
+			set_parent(parent_id);
 		}
 
 		inline bool
@@ -204,8 +269,8 @@ class search_node
 		{
 			out << "search_node id:" << get_id();
             out << " p_id: ";
-            out << parent_id_;
-            out << " g: "<<g_ <<" f: "<<this->get_f() << " ub: " << ub_
+            out << get_parent();
+            out << " g: "<<g_ <<" f: "<<this->get_f() << " ub: " << get_ub()
                 << " expanded: " << get_expanded() << " "
                 << " search_number_: " << search_number_;
 		}
@@ -220,6 +285,29 @@ class search_node
         get_refcount() { return refcount_; }
 
 	private:
+#ifdef WARTHOG_COMPACT_SEARCH_NODE
+		static const uint32_t EXPANDED_BIT = 1u << 31;
+		static const uint32_t PRIORITY_MASK = EXPANDED_BIT - 1;
+
+		static inline uint32_t
+		pack_id(warthog::sn_id_t id)
+		{
+			assert(id == warthog::SN_ID_MAX || id < UINT32_MAX);
+			return (uint32_t)id;
+		}
+
+		static inline warthog::sn_id_t
+		unpack_id(uint32_t id)
+		{ return id == UINT32_MAX ? warthog::SN_ID_MAX : id; }
+
+		uint32_t id_;
+		uint32_t parent_id_;
+
+        warthog::cost_t g_;
+        warthog::cost_t f_;
+
+		uint32_t priority_; // expansion priority; high bit: open or closed
+#else
 		warthog::sn_id_t id_;
         warthog::sn_id_t parent_id_;
 
@@ -230,9 +318,10 @@ class search_node
         // TODO steal the high-bit from priority instead of ::status_ ?
         uint8_t status_; // open or closed
 		uint32_t priority_; // expansion priority
+#endif
 
 		uint32_t search_number_;
-        static uint32_t refcount_;
+        static std::atomic<uint32_t> refcount_;
 };
 
 struct cmp_less_search_node
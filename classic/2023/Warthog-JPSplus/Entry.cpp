@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
 #include "Entry.h"
 #include <domains/gridmap.h>
 #include <jps/jps2_expansion_policy.h>
@@ -12,9 +14,42 @@
 
 #define JPS_PLUS
 
-struct WarthogAlg
+// read-only map data. built once per map and shared by every search
+// context created for that map, so N search threads hold one copy of
+// the grid and of the jump point database.
+struct WarthogMap
 {
 	warthog::gridmap map;
+#ifdef JPS_PLUS
+	warthog::offline_jump_point_locator jpl;
+#else
+	std::unique_ptr<warthog::gridmap> rmap;
+#endif
+
+	WarthogMap(const std::vector<bool>& bits, int width, int height, [[maybe_unused]] const std::string& filename) : map(bits.begin(), bits.end(), height, width)
+#ifdef JPS_PLUS
+		,jpl(&map, filename)
+#else
+		,rmap(warthog::jps::online_jump_point_locator2::create_rmap(&map))
+#endif
+	{ }
+
+	// the map arrives packed, so map and rmap are copied a word at a time
+	WarthogMap(const GPPC::BitGrid& grid, [[maybe_unused]] const std::string& filename) : map(grid.bits, grid.stride, grid.height, grid.width)
+#ifdef JPS_PLUS
+		,jpl(&map, filename)
+#else
+		,rmap(grid.transposed
+			? new warthog::gridmap(grid.transposed, grid.tstride, grid.width, grid.height, true)
+			: warthog::jps::online_jump_point_locator2::create_rmap(&map))
+#endif
+	{ }
+};
+
+// per-thread search state: node pool, open list and search numbers.
+struct WarthogAlg
+{
+	std::shared_ptr<WarthogMap> shared;
 #ifdef JPS_PLUS
 	warthog::jpsplus_expansion_policy expander;
 #else
@@ -33,46 +68,89 @@ struct WarthogAlg
 	warthog::pqueue_min> 
 	astar;
 	warthog::solution sol;
+	uint32_t search_number;
+	// nodes expanded and generated since the last GetSearchStats call
+	uint64_t expanded, generated;
 
-	WarthogAlg(const std::vector<bool>& bits, int width, int height, const std::string& filename) : map(bits.begin(), bits.end(), height, width)
+	WarthogAlg(std::shared_ptr<WarthogMap> data) : shared(std::move(data))
 #ifdef JPS_PLUS
-		,expander(&map, filename)
+		,expander(&shared->map, &shared->jpl)
 #else
-		,expander(&map)
+		,expander(&shared->map, shared->rmap.get())
 #endif
-		,heuristic(map.width(), map.height())
+		,heuristic(shared->map.width(), shared->map.height())
 		,astar(&heuristic, &expander, &open)
+		,search_number(0)
+		,expanded(0)
+		,generated(0)
 	{ }
 };
 
-void PreprocessMap(const std::vector<bool> &bits, int width, int height, const std::string& filename)
+// PrepareForSearch may be called once per search thread; every call for
+// the same map returns a new context on top of the same WarthogMap.
+// @param args: passed on to the WarthogMap constructor
+template <typename... Args>
+static std::shared_ptr<WarthogMap> GetSharedMap(const std::string& filename, const Args&... args)
+{
+	static std::mutex lock;
+	static std::map<std::string, std::weak_ptr<WarthogMap>> maps;
+	std::lock_guard<std::mutex> guard(lock);
+	std::shared_ptr<WarthogMap> data = maps[filename].lock();
+	if (!data) {
+		data = std::make_shared<WarthogMap>(args...);
+		maps[filename] = data;
+	}
+	return data;
+}
+
+void PreprocessMap([[maybe_unused]] const std::vector<bool> &bits, [[maybe_unused]] int width, [[maybe_unused]] int height, [[maybe_unused]] const std::string& filename)
 {
 #ifdef JPS_PLUS
 	warthog::gridmap map(bits.begin(), bits.end(), height, width);
-	warthog::jps2plus_expansion_policy expander(&map, filename);
+	warthog::offline_jump_point_locator jpl(&map, filename);
 #endif
 }
 
+// the online locator has nothing to build, so only JPS+ needs this overload
+#ifdef JPS_PLUS
+void PreprocessMap(const GPPC::BitGrid& grid, const std::string& filename)
+{
+	warthog::gridmap map(grid.bits, grid.stride, grid.height, grid.width);
+	warthog::offline_jump_point_locator jpl(&map, filename);
+}
+#endif
+
 void *PrepareForSearch(const std::vector<bool> &bits, int width, int height, const std::string& filename) {
-	return new WarthogAlg(bits, width, height, filename);
+	return new WarthogAlg(GetSharedMap(filename, bits, width, height, filename));
+}
+
+void *PrepareForSearch(const GPPC::BitGrid& grid, const std::string& filename) {
+	return new WarthogAlg(GetSharedMap(filename, grid, filename));
+}
+
+static void CountSearch(WarthogAlg* alg, const warthog::solution& sol) {
+	alg->expanded += sol.met_.nodes_expanded_;
+	alg->generated += sol.met_.nodes_generated_;
 }
 
 bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path) {
 	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
 	
-	const auto width = static_cast<warthog::sn_id_t>(alg->map.header_width());
+	warthog::gridmap& map = alg->shared->map;
+	const auto width = static_cast<warthog::sn_id_t>(map.header_width());
 	warthog::sn_id_t startid =static_cast<warthog::sn_id_t>(s.y) * width + static_cast<warthog::sn_id_t>(s.x);
 	warthog::sn_id_t goalid = static_cast<warthog::sn_id_t>(g.y) * width + static_cast<warthog::sn_id_t>(g.x);
-	warthog::problem_instance pi(startid, goalid, false);
+	warthog::problem_instance pi(startid, goalid, alg->search_number++, false);
 
 	alg->astar.get_path(pi, alg->sol);
+	CountSearch(alg, alg->sol);
 	if (alg->sol.path_.empty())
 		return true;
 	
 	path.reserve(2*alg->sol.path_.size());
 	for (auto jid : alg->sol.path_) {
 		xyLoc xy;
-		auto j = alg->map.to_unpadded_id(jid);
+		auto j = map.to_unpadded_id(jid);
 		xy.x = static_cast<int16_t>(j % width);
 		xy.y = static_cast<int16_t>(j / width);
 		if (!path.empty()) {
@@ -97,6 +175,37 @@ bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path) {
 	return true;
 }
 
+// jump point search stops jumping when it reaches the goal, so one search
+// cannot be resumed towards another goal; answer each query on its own.
+void GetPaths(void *data, const std::vector<std::pair<xyLoc, xyLoc>> &queries, std::vector<std::vector<xyLoc>> &paths) {
+	paths.resize(queries.size());
+	for (size_t i = 0; i < queries.size(); i++) {
+		paths[i].clear();
+		GetPath(data, queries[i].first, queries[i].second, paths[i]);
+	}
+}
+
+void GetSearchStats(void *data, uint64_t &expanded, uint64_t &generated) {
+	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
+	expanded += alg->expanded;
+	generated += alg->generated;
+	alg->expanded = alg->generated = 0;
+}
+
+// contexts share only the read-only WarthogMap
+bool ThreadSafeSearch() { return true; }
+
+// the shared map goes with the last context using it
+void ReleaseSearch(void *data) {
+	delete static_cast<WarthogAlg*>(data);
+}
+
+// astar.mem() covers the open list, the node pool and, through the expander, the map
+size_t GetMemoryUsage(void *data) {
+	WarthogAlg* alg = static_cast<WarthogAlg*>(data);
+	return sizeof(WarthogAlg) + alg->astar.mem();
+}
+
 std::string GetName()
 {
 #ifdef JPS_PLUS
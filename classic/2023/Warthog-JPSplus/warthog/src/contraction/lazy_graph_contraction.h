@@ -139,8 +139,8 @@ class lazy_graph_contraction
         uint32_t
         next(bool verify_priorities, uint32_t c_pct);
 
-        double
-        witness_search(uint32_t from_id, uint32_t to_id, double via_len, bool resume);
+        warthog::cost_t
+        witness_search(uint32_t from_id, uint32_t to_id, warthog::cost_t via_len, bool resume);
 
         int32_t
         contract_node(uint32_t node_id, bool metrics_only);
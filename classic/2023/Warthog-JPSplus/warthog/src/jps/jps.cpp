@@ -213,7 +213,7 @@ warthog::jps::create_jump_point_graph(warthog::gridmap* gm)
         {
             warthog::jps::direction d = (warthog::jps::direction)(1 << i);
             std::vector<uint32_t> jpoints;
-            std::vector<double> jcosts;
+            std::vector<warthog::cost_t> jcosts;
             jpl.jump(d, gm_id, warthog::INF32, jpoints, jcosts);
             for(uint32_t idx = 0; idx < jpoints.size(); idx++)
             {
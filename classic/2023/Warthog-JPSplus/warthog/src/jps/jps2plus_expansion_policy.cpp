@@ -8,6 +8,20 @@ warthog::jps2plus_expansion_policy::jps2plus_expansion_policy(warthog::gridmap*
 {
 	map_ = map;
 	jpl_ = new warthog::offline_jump_point_locator2(map, preFilename);
+	owns_jpl_ = true;
+
+	costs_.reserve(100);
+	jp_ids_.reserve(100);
+    reset();
+}
+
+warthog::jps2plus_expansion_policy::jps2plus_expansion_policy(
+        warthog::gridmap* map, warthog::offline_jump_point_locator2* jpl)
+    : expansion_policy(map->height() * map->width())
+{
+	map_ = map;
+	jpl_ = jpl;
+	owns_jpl_ = false;
 
 	costs_.reserve(100);
 	jp_ids_.reserve(100);
@@ -16,7 +30,7 @@ warthog::jps2plus_expansion_policy::jps2plus_expansion_policy(warthog::gridmap*
 
 warthog::jps2plus_expansion_policy::~jps2plus_expansion_policy()
 {
-	delete jpl_;
+	if(owns_jpl_) { delete jpl_; }
 }
 
 void 
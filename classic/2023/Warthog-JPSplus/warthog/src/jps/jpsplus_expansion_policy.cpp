@@ -9,11 +9,21 @@ warthog::jpsplus_expansion_policy::jpsplus_expansion_policy(warthog::gridmap* ma
 {
 	map_ = map;
 	jpl_ = new warthog::offline_jump_point_locator(map, preFilename);
+	owns_jpl_ = true;
+}
+
+warthog::jpsplus_expansion_policy::jpsplus_expansion_policy(
+        warthog::gridmap* map, warthog::offline_jump_point_locator* jpl)
+    : expansion_policy(map->height() * map->width())
+{
+	map_ = map;
+	jpl_ = jpl;
+	owns_jpl_ = false;
 }
 
 warthog::jpsplus_expansion_policy::~jpsplus_expansion_policy()
 {
-	delete jpl_;
+	if(owns_jpl_) { delete jpl_; }
 }
 
 void 
@@ -40,7 +50,7 @@ warthog::jpsplus_expansion_policy::expand(
 		warthog::jps::direction d = (warthog::jps::direction) (1 << i);
 		if(succ_dirs & d)
 		{
-			double jumpcost;
+			warthog::cost_t jumpcost;
 			uint32_t succ_id;
 			jpl_->jump(d, current_id, goal_id, succ_id, jumpcost);
 
@@ -30,6 +30,11 @@ class jpsplus_expansion_policy : public expansion_policy
 	public:
 		jpsplus_expansion_policy(warthog::gridmap* map);
 		jpsplus_expansion_policy(warthog::gridmap* map, const std::string& preFilename);
+
+		// use a jump point database loaded elsewhere. @param jpl is not
+		// owned by the policy and can be shared by several policies.
+		jpsplus_expansion_policy(warthog::gridmap* map, 
+				warthog::offline_jump_point_locator* jpl);
 		virtual ~jpsplus_expansion_policy();
 
 		virtual void 
@@ -56,6 +61,7 @@ class jpsplus_expansion_policy : public expansion_policy
 	private:
 		warthog::gridmap* map_;
 		offline_jump_point_locator* jpl_;
+		bool owns_jpl_;
 
 		// computes the direction of travel; from a node n1
 		// to a node n2.
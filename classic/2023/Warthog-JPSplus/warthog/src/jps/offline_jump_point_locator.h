@@ -5,12 +5,15 @@
 //
 // Identifies jump points using a pre-computed database that stores
 // distances from each node to jump points in every direction.
+// Once constructed the locator is read-only, so a single instance
+// can answer ::jump calls from several threads at once.
 //
 // @author: dharabor
 // @created: 05/05/2013
 //
 
 #include "jps.h"
+#include "jump_table.h"
 
 namespace warthog
 {
@@ -25,12 +28,12 @@ class offline_jump_point_locator
 
 		void
 		jump(warthog::jps::direction d, uint32_t node_id, uint32_t goalid, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 
 		uint32_t
 		mem()
 		{
-			return sizeof(this) + sizeof(*db_)*dbsize_;
+			return sizeof(this) + table_.mem();
 		}
 
 
@@ -47,38 +50,32 @@ class offline_jump_point_locator
 
 		void
 		jump_northwest(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_northeast(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_southwest(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_southeast(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_north(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_south(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_east(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 		void
 		jump_west(uint32_t node_id, uint32_t goal_id, 
-				uint32_t& jumpnode_id, double& jumpcost);
+				uint32_t& jumpnode_id, warthog::cost_t& jumpcost);
 
 		warthog::gridmap* map_;
-		uint32_t dbsize_;
-		uint16_t* db_;	
+		warthog::jps::jump_table table_;
 		std::string preFilename_;
-
-		//uint32_t jumppoints_[3];
-		//double costs_[3];
-		uint32_t max_;
-		uint32_t current_;
 };
 
 }
@@ -32,7 +32,6 @@ warthog::offline_jump_point_locator2::offline_jump_point_locator2(warthog::gridm
 
 warthog::offline_jump_point_locator2::~offline_jump_point_locator2()
 {
-	delete [] db_;
 }
 
 void
@@ -46,9 +45,7 @@ warthog::offline_jump_point_locator2::preproc()
 	}
 	if (fname != nullptr && load(fname, append)) { return; }
 
-	dbsize_ = 8*map_->padded_mapsize();
-	db_ = new uint16_t[dbsize_];
-	for(uint32_t i=0; i < dbsize_; i++) db_[i] = 0;
+	std::vector<uint16_t> labels(8*map_->padded_mapsize(), 0);
 
 	warthog::online_jump_point_locator jpl(map_);
 	for(uint32_t y = 0; y < map_->header_height(); y++)
@@ -63,22 +60,20 @@ warthog::offline_jump_point_locator2::preproc()
 					(warthog::jps::direction)(1 << i);
 //				std::cout << dir << ": ";
 				uint32_t jumpnode_id;
-				double jumpcost;
+				warthog::cost_t jumpcost;
 				jpl.jump(dir, mapid,
 						warthog::INF32, jumpnode_id, jumpcost);
 				
 				// convert from cost to number of steps
-				if(dir > 8)
-				{
-					jumpcost = (jumpcost / warthog::DBL_ROOT_TWO);
-				}
-				uint32_t num_steps = (uint16_t)floor((jumpcost + 0.5));
+				double steps = (double)jumpcost / (dir > 8 ?
+						warthog::DIAG_COST : warthog::CARD_COST);
+				uint32_t num_steps = (uint16_t)floor((steps + 0.5));
 //				std::cout << (jumpnode_id == warthog::INF ? 0 : num_steps) << " ";
 
 				// set the leading bit if the jump leads to a dead-end
 				if(jumpnode_id == warthog::INF32)
 				{
-					db_[mapid*8 + i] |= 32768;
+					labels[mapid*8 + i] |= 32768;
 				}
 
 				// truncate jump cost so we can fit the label into a single byte
@@ -88,7 +83,7 @@ warthog::offline_jump_point_locator2::preproc()
 				//	jumpnode_id = 0; 
 				//}
 
-				db_[mapid*8 + i] |= num_steps;
+				labels[mapid*8 + i] |= num_steps;
 
 				if(num_steps > 32768)
 				{
@@ -100,6 +95,8 @@ warthog::offline_jump_point_locator2::preproc()
 		}
 	}
 
+	table_.assign(labels);
+
 	if (fname != nullptr)
 		save(fname, append);
 }
@@ -108,54 +105,28 @@ warthog::offline_jump_point_locator2::preproc()
 bool
 warthog::offline_jump_point_locator2::load(const char* filename, bool append)
 {
-	char fname[256];
-	strcpy(fname, filename);
+	std::string fname(filename);
 	if (append)
-		strcat(fname, ".jps+");
-	FILE* f = fopen(fname, "rb");
-	std::cerr << "loading "<<fname << "... ";
-	if(f == NULL) 
-	{
-		std::cerr << "no dice. oh well. keep going.\n"<<std::endl;
-		return false;
-	}
-	
-	fread(&dbsize_, sizeof(dbsize_), 1, f);
-	std::cerr <<"#labels="<<dbsize_<<std::endl;
-
-	db_ = new uint16_t[dbsize_];
-	fread(db_, sizeof(uint16_t), dbsize_, f);
-	fclose(f);
-	return true;
+		fname += ".jps+";
+	return table_.load(fname.c_str(), map_);
 }
 
 void 
 warthog::offline_jump_point_locator2::save(const char* filename, bool append)
 {
-	char fname[256];
-	strcpy(fname, filename);
+	std::string fname(filename);
 	if (append)
-		strcat(fname, ".jps+");
-	std::cerr << "saving to file "<<fname<<"; nodes="<<dbsize_<<" size: "<<sizeof(db_[0])<<std::endl;
-
-	FILE* f = fopen(fname, "wb");
-	if(f == NULL) 
+		fname += ".jps+";
+	if(table_.save(fname.c_str(), map_))
 	{
-		std::cerr << "err; cannot write jump-point graph to file "
-			<<fname<<". oh well. try to keep going.\n"<<std::endl;
-		return;
+		std::cerr << "jump table saved to disk. file="<<fname<<std::endl;
 	}
-
-	fwrite(&dbsize_, sizeof(dbsize_), 1, f);
-	fwrite(db_, sizeof(*db_), dbsize_, f);
-	fclose(f);
-	std::cerr << "jump table saved to disk. file="<<fname<<std::endl;
 }
 
 void
 warthog::offline_jump_point_locator2::jump(warthog::jps::direction d, 
 		uint32_t node_id, uint32_t goal_id, 
-		std::vector<uint32_t>& neighbours, std::vector<double>& costs)
+		std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs)
 {
 	switch(d)
 	{
@@ -191,7 +162,7 @@ warthog::offline_jump_point_locator2::jump(warthog::jps::direction d,
 void
 warthog::offline_jump_point_locator2::jump_northwest(uint32_t node_id,
 	  	uint32_t goal_id,
-		std::vector<uint32_t>& neighbours, std::vector<double>& costs)
+		std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs)
 
 {
 	uint16_t label = 0;
@@ -205,32 +176,34 @@ warthog::offline_jump_point_locator2::jump_northwest(uint32_t node_id,
 	uint32_t jump_from = node_id;
 	
 	// step diagonally to an intermediate location jump_from
-	label = db_[8*jump_from + 5];
+	label = table_.label(8*jump_from + 5);
 	num_steps += label & 32767;
 	jump_from = node_id - num_steps * diag_step_delta;
 	while(!(label & 32768))
 	{
 		// north of jump_from
-		uint16_t label_straight1 = db_[8*jump_from]; 
+		uint16_t label_straight1 = table_.label(8*jump_from); 
 		if(!(label_straight1 & 32768)) 
 		{ 
 			uint32_t jp_cost = (label_straight1 & 32767);
 			uint32_t jp_id = jump_from - mapw *  jp_cost;
 			*(((uint8_t*)&jp_id)+3) = warthog::jps::NORTH;
 			neighbours.push_back(jp_id);
-			costs.push_back(jp_cost + num_steps * warthog::DBL_ROOT_TWO);
+			costs.push_back(jp_cost * warthog::CARD_COST +
+					num_steps * warthog::DIAG_COST);
 		}
 		// west of jump_from
-		uint16_t label_straight2 = db_[8*jump_from+3]; // west of next jp
+		uint16_t label_straight2 = table_.label(8*jump_from+3); // west of next jp
 		if(!(label_straight2 & 32768)) 
 		{ 
 			uint32_t jp_cost = (label_straight2 & 32767);
 			uint32_t jp_id = jump_from - jp_cost;
 			*(((uint8_t*)&jp_id)+3) = warthog::jps::WEST;
 			neighbours.push_back(jp_id);
-			costs.push_back(jp_cost + num_steps * warthog::DBL_ROOT_TWO);
+			costs.push_back(jp_cost * warthog::CARD_COST +
+					num_steps * warthog::DIAG_COST);
 		}
-		label = db_[8*jump_from + 5];
+		label = table_.label(8*jump_from + 5);
 		num_steps += label & 32767;
 		jump_from = node_id - num_steps * diag_step_delta;
 	}
@@ -249,13 +222,13 @@ warthog::offline_jump_point_locator2::jump_northwest(uint32_t node_id,
 			if(ydelta < xdelta && ydelta <= num_steps)
 			{
 				uint32_t jp_id = node_id - diag_step_delta * ydelta;
-				double jp_cost = warthog::DBL_ROOT_TWO * ydelta;
+				warthog::cost_t jp_cost = warthog::DIAG_COST * ydelta;
 				jump_west(jp_id, goal_id, jp_cost, neighbours, costs);
 			}
 			else if(xdelta <= num_steps)
 			{
 				uint32_t jp_id = node_id - diag_step_delta * xdelta;
-				double jp_cost = warthog::DBL_ROOT_TWO * xdelta;
+				warthog::cost_t jp_cost = warthog::DIAG_COST * xdelta;
 				jump_north(jp_id, goal_id, jp_cost, neighbours, costs);
 			}
 		}
@@ -265,7 +238,7 @@ warthog::offline_jump_point_locator2::jump_northwest(uint32_t node_id,
 void
 warthog::offline_jump_point_locator2::jump_northeast(uint32_t node_id,
 	  	uint32_t goal_id, 
-		std::vector<uint32_t>& neighbours, std::vector<double>& costs)
+		std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs)
 {
 	uint16_t label = 0;
 	uint16_t num_steps = 0;
@@ -274,33 +247,35 @@ warthog::offline_jump_point_locator2::jump_northeast(uint32_t node_id,
 	
 	uint32_t jump_from = node_id;
 	// step diagonally to an intermediate location jump_from
-	label = db_[8*jump_from + 4];
+	label = table_.label(8*jump_from + 4);
 	num_steps += label & 32767;
 	jump_from = node_id - num_steps * diag_step_delta;
 	while(!(label & 32768))
 	{
 
 		// north of jump_from
-		uint16_t label_straight1 = db_[8*jump_from]; 
+		uint16_t label_straight1 = table_.label(8*jump_from); 
 		if(!(label_straight1 & 32768)) 
 		{ 
 			uint32_t jp_cost = (label_straight1 & 32767);
 			uint32_t jp_id = jump_from - mapw *  jp_cost;
 			*(((uint8_t*)&jp_id)+3) = warthog::jps::NORTH;
 			neighbours.push_back(jp_id);
-			costs.push_back(jp_cost + num_steps * warthog::DBL_ROOT_TWO);
+			costs.push_back(jp_cost * warthog::CARD_COST +
+					num_steps * warthog::DIAG_COST);
 		}
 		// east of jump_from
-		uint16_t label_straight2 = db_[8*jump_from+2]; 
+		uint16_t label_straight2 = table_.label(8*jump_from+2); 
 		if(!(label_straight2 & 32768)) 
 		{ 
 			uint32_t jp_cost = (label_straight2 & 32767);
 			uint32_t jp_id = jump_from + jp_cost;
 			*(((uint8_t*)&jp_id)+3) = warthog::jps::EAST;
 			neighbours.push_back(jp_id);
-			costs.push_back(jp_cost + num_steps * warthog::DBL_ROOT_TWO);
+			costs.push_back(jp_cost * warthog::CARD_COST +
+					num_steps * warthog::DIAG_COST);
 		}
-		label = db_[8*jump_from + 4];
+		label = table_.label(8*jump_from + 4);
 		num_steps += label & 32767;
 		jump_from = node_id - num_steps * diag_step_delta;
 	}
@@ -319,13 +294,13 @@ warthog::offline_jump_point_locator2::jump_northeast(uint32_t node_id,
 			if(ydelta < xdelta && ydelta <= num_steps)
 			{
 				uint32_t jp_id = node_id - diag_step_delta * ydelta;
-				double jp_cost = warthog::DBL_ROOT_TWO * ydelta;
+				warthog::cost_t jp_cost = warthog::DIAG_COST * ydelta;
 				jump_east(jp_id, goal_id, jp_cost, neighbours, costs);
 			}
 			else if(xdelta <= num_steps)
 			{
 				uint32_t jp_id = node_id - diag_step_delta * xdelta;
-				double jp_cost = warthog::DBL_ROOT_TWO * xdelta;
+				warthog::cost_t jp_cost = warthog::DIAG_COST * xdelta;
 				jump_north(jp_id, goal_id, jp_cost, neighbours, costs);
 			}
 		}
@@ -335,7 +310,7 @@ warthog::offline_jump_point_locator2::jump_northeast(uint32_t node_id,
 void
 warthog::offline_jump_point_locator2::jump_southwest(uint32_t node_id,
 	  	uint32_t goal_id, 
-		std::vector<uint32_t>& neighbours, std::vector<double>& costs)
+		std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs)
 {
 	uint32_t mapw = map_->width();
 	uint32_t diag_step_delta = (mapw - 1);
@@ -344,32 +319,34 @@ warthog::offline_jump_point_locator2::jump_southwest(uint32_t node_id,
 
 	uint32_t jump_from = node_id;
 	// step diagonally to an intermediate location jump_from
-	label = db_[8*jump_from + 7];
+	label = table_.label(8*jump_from + 7);
 	num_steps += label & 32767;
 	jump_from = node_id + num_steps * diag_step_delta;
 	while(!(label & 32768))
 	{
 		// south of jump_from
-		uint16_t label_straight1 = db_[8*jump_from+1]; 
+		uint16_t label_straight1 = table_.label(8*jump_from+1); 
 		if(!(label_straight1 & 32768)) 
 		{ 
 			uint32_t jp_cost = (label_straight1 & 32767);
 			uint32_t jp_id = jump_from + mapw *  jp_cost;
 			*(((uint8_t*)&jp_id)+3) = warthog::jps::SOUTH;
 			neighbours.push_back(jp_id);
-			costs.push_back(jp_cost + num_steps * warthog::DBL_ROOT_TWO);
+			costs.push_back(jp_cost * warthog::CARD_COST +
+					num_steps * warthog::DIAG_COST);
 		}
 		// west of jump_from
-		uint16_t label_straight2 = db_[8*jump_from+3]; 
+		uint16_t label_straight2 = table_.label(8*jump_from+3); 
 		if(!(label_straight2 & 32768)) 
 		{ 
 			uint32_t jp_cost = (label_straight2 & 32767);
 			uint32_t jp_id = jump_from - jp_cost;
 			*(((uint8_t*)&jp_id)+3) = warthog::jps::WEST;
 			neighbours.push_back(jp_id);
-			costs.push_back(jp_cost + num_steps * warthog::DBL_ROOT_TWO);
+			costs.push_back(jp_cost * warthog::CARD_COST +
+					num_steps * warthog::DIAG_COST);
 		}
-		label = db_[8*jump_from + 7];
+		label = table_.label(8*jump_from + 7);
 		num_steps += label & 32767;
 		jump_from = node_id + num_steps * diag_step_delta;
 	}
@@ -388,13 +365,13 @@ warthog::offline_jump_point_locator2::jump_southwest(uint32_t node_id,
 			if(ydelta < xdelta && ydelta <= num_steps)
 			{
 				uint32_t jp_id = node_id + diag_step_delta * ydelta;
-				double jp_cost = warthog::DBL_ROOT_TWO * ydelta;
+				warthog::cost_t jp_cost = warthog::DIAG_COST * ydelta;
 				jump_west(jp_id, goal_id, jp_cost, neighbours, costs);
 			}
 			else if(xdelta <= num_steps)
 			{
 				uint32_t jp_id = node_id + diag_step_delta * xdelta;
-				double jp_cost = warthog::DBL_ROOT_TWO * xdelta;
+				warthog::cost_t jp_cost = warthog::DIAG_COST * xdelta;
 				jump_south(jp_id, goal_id, jp_cost, neighbours, costs);
 			}
 		}
@@ -404,7 +381,7 @@ warthog::offline_jump_point_locator2::jump_southwest(uint32_t node_id,
 void
 warthog::offline_jump_point_locator2::jump_southeast(uint32_t node_id,
 	  	uint32_t goal_id, 
-		std::vector<uint32_t>& neighbours, std::vector<double>& costs)
+		std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs)
 	
 {
 	uint16_t label = 0;
@@ -415,33 +392,35 @@ warthog::offline_jump_point_locator2::jump_southeast(uint32_t node_id,
 	uint32_t jump_from = node_id;
 	
 	// step diagonally to an intermediate location jump_from
-	label = db_[8*jump_from + 6];
+	label = table_.label(8*jump_from + 6);
 	num_steps += label & 32767;
 	jump_from = node_id + num_steps * diag_step_delta;
 	while(!(label & 32768))
 	{
 		// south of jump_from
-		uint16_t label_straight1 = db_[8*jump_from + 1]; 
+		uint16_t label_straight1 = table_.label(8*jump_from + 1); 
 		if(!(label_straight1 & 32768)) 
 		{ 
 			uint32_t jp_cost = (label_straight1 & 32767);
 			uint32_t jp_id = jump_from + mapw * jp_cost;
 			*(((uint8_t*)&jp_id)+3) = warthog::jps::SOUTH;
 			neighbours.push_back(jp_id);
-			costs.push_back(jp_cost + num_steps * warthog::DBL_ROOT_TWO);
+			costs.push_back(jp_cost * warthog::CARD_COST +
+					num_steps * warthog::DIAG_COST);
 		}
 		// east of jump_from
-		uint16_t label_straight2 = db_[8*jump_from + 2]; 
+		uint16_t label_straight2 = table_.label(8*jump_from + 2); 
 		if(!(label_straight2 & 32768)) 
 		{ 
 			uint32_t jp_cost = (label_straight2 & 32767);
 			uint32_t jp_id = jump_from + jp_cost;
 			*(((uint8_t*)&jp_id)+3) = warthog::jps::EAST;
 			neighbours.push_back(jp_id);
-			costs.push_back(jp_cost + num_steps * warthog::DBL_ROOT_TWO);
+			costs.push_back(jp_cost * warthog::CARD_COST +
+					num_steps * warthog::DIAG_COST);
 		}
 		// step diagonally to an intermediate location jump_from
-		label = db_[8*jump_from + 6];
+		label = table_.label(8*jump_from + 6);
 		num_steps += label & 32767;
 		jump_from = node_id + num_steps * diag_step_delta;
 	}
@@ -460,13 +439,13 @@ warthog::offline_jump_point_locator2::jump_southeast(uint32_t node_id,
 			if(ydelta < xdelta && ydelta <= num_steps)
 			{
 				uint32_t jp_id = node_id + diag_step_delta * ydelta;
-				double jp_cost = warthog::DBL_ROOT_TWO * ydelta;
+				warthog::cost_t jp_cost = warthog::DIAG_COST * ydelta;
 				jump_east(jp_id, goal_id, jp_cost, neighbours, costs);
 			}
 			else if(xdelta <= num_steps)
 			{
 				uint32_t jp_id = node_id + diag_step_delta * xdelta;
-				double jp_cost = warthog::DBL_ROOT_TWO * xdelta;
+				warthog::cost_t jp_cost = warthog::DIAG_COST * xdelta;
 				jump_south(jp_id, goal_id, jp_cost, neighbours, costs);
 			}
 		}
@@ -475,10 +454,10 @@ warthog::offline_jump_point_locator2::jump_southeast(uint32_t node_id,
 
 void
 warthog::offline_jump_point_locator2::jump_north(uint32_t node_id,
-	  	uint32_t goal_id, double cost_to_node_id,
-		std::vector<uint32_t>& neighbours, std::vector<double>& costs)
+	  	uint32_t goal_id, warthog::cost_t cost_to_node_id,
+		std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs)
 {
-	uint16_t label = db_[8*node_id];
+	uint16_t label = table_.label(8*node_id);
 	uint16_t num_steps = label & 32767;
 
 	// do not jump over the goal
@@ -492,7 +471,8 @@ warthog::offline_jump_point_locator2::jump_north(uint32_t node_id,
 		{ 
 			*(((uint8_t*)&goal_id)+3) = warthog::jps::NORTH;
 			neighbours.push_back(goal_id);
-			costs.push_back((goal_delta / map_->width()) + cost_to_node_id);
+			costs.push_back((goal_delta / map_->width()) * warthog::CARD_COST +
+					cost_to_node_id);
 			return;
 		}
 	}
@@ -503,16 +483,16 @@ warthog::offline_jump_point_locator2::jump_north(uint32_t node_id,
 		uint32_t jp_id = node_id - id_delta;
 		*(((uint8_t*)&jp_id)+3) = warthog::jps::NORTH;
 		neighbours.push_back(jp_id);
-		costs.push_back(num_steps + cost_to_node_id);
+		costs.push_back(num_steps * warthog::CARD_COST + cost_to_node_id);
 	}
 }
 
 void
 warthog::offline_jump_point_locator2::jump_south(uint32_t node_id,
-	  	uint32_t goal_id, double cost_to_node_id, 
-		std::vector<uint32_t>& neighbours, std::vector<double>& costs)
+	  	uint32_t goal_id, warthog::cost_t cost_to_node_id, 
+		std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs)
 {
-	uint16_t label = db_[8*node_id + 1];
+	uint16_t label = table_.label(8*node_id + 1);
 	uint16_t num_steps = label & 32767;
 	
 	// do not jump over the goal
@@ -526,7 +506,8 @@ warthog::offline_jump_point_locator2::jump_south(uint32_t node_id,
 		{ 
 			*(((uint8_t*)&goal_id)+3) = warthog::jps::SOUTH;
 			neighbours.push_back(goal_id);
-			costs.push_back((goal_delta / map_->width() ) + cost_to_node_id);
+			costs.push_back((goal_delta / map_->width()) * warthog::CARD_COST +
+					cost_to_node_id);
 			return;
 		}
 	}
@@ -537,16 +518,16 @@ warthog::offline_jump_point_locator2::jump_south(uint32_t node_id,
 		uint32_t jp_id = (node_id + id_delta);
 		*(((uint8_t*)&jp_id)+3) = warthog::jps::SOUTH;
 		neighbours.push_back(jp_id);
-		costs.push_back(num_steps + cost_to_node_id);
+		costs.push_back(num_steps * warthog::CARD_COST + cost_to_node_id);
 	}
 }
 
 void
 warthog::offline_jump_point_locator2::jump_east(uint32_t node_id,
-	  	uint32_t goal_id, double cost_to_node_id,
-		std::vector<uint32_t>& neighbours, std::vector<double>& costs)
+	  	uint32_t goal_id, warthog::cost_t cost_to_node_id,
+		std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs)
 {
-	uint16_t label = db_[8*node_id + 2];
+	uint16_t label = table_.label(8*node_id + 2);
 	uint32_t num_steps = label & 32767;
 
 	// do not jump over the goal
@@ -555,7 +536,7 @@ warthog::offline_jump_point_locator2::jump_east(uint32_t node_id,
 	{
 		*(((uint8_t*)&goal_id)+3) = warthog::jps::EAST;
 		neighbours.push_back(goal_id);
-		costs.push_back(goal_delta + cost_to_node_id);
+		costs.push_back(goal_delta * warthog::CARD_COST + cost_to_node_id);
 		return;
 	}
 
@@ -565,16 +546,16 @@ warthog::offline_jump_point_locator2::jump_east(uint32_t node_id,
 		uint32_t jp_id = (node_id + num_steps);
 		*(((uint8_t*)&jp_id)+3) = warthog::jps::EAST;
 		neighbours.push_back(jp_id);
-		costs.push_back(num_steps + cost_to_node_id);
+		costs.push_back(num_steps * warthog::CARD_COST + cost_to_node_id);
 	}
 }
 
 void
 warthog::offline_jump_point_locator2::jump_west(uint32_t node_id,
-	  	uint32_t goal_id, double cost_to_node_id,
-		std::vector<uint32_t>& neighbours, std::vector<double>& costs)
+	  	uint32_t goal_id, warthog::cost_t cost_to_node_id,
+		std::vector<uint32_t>& neighbours, std::vector<warthog::cost_t>& costs)
 {
-	uint16_t label = db_[8*node_id + 3];
+	uint16_t label = table_.label(8*node_id + 3);
 	uint32_t num_steps = label & 32767;
 
 	// do not jump over the goal
@@ -583,7 +564,7 @@ warthog::offline_jump_point_locator2::jump_west(uint32_t node_id,
 	{
 		*(((uint8_t*)&goal_id)+3) = warthog::jps::WEST;
 		neighbours.push_back(goal_id);
-		costs.push_back(goal_delta + cost_to_node_id);
+		costs.push_back(goal_delta * warthog::CARD_COST + cost_to_node_id);
 		return;
 	}
 
@@ -593,7 +574,7 @@ warthog::offline_jump_point_locator2::jump_west(uint32_t node_id,
 		uint32_t jp_id = node_id - num_steps;
 		*(((uint8_t*)&jp_id)+3) = warthog::jps::WEST;
 		neighbours.push_back(jp_id);
-		costs.push_back(num_steps + cost_to_node_id);
+		costs.push_back(num_steps * warthog::CARD_COST + cost_to_node_id);
 	}
 }
 
@@ -92,6 +92,7 @@ warthog::online_jump_point_locator::jump_north(uint32_t node_id,
 	goal_id = this->map_id_to_rmap_id(goal_id);
 	__jump_north(node_id, goal_id, jumpnode_id, jumpcost, rmap_);
 	jumpnode_id = this->rmap_id_to_map_id(jumpnode_id);
+	jumpcost *= warthog::CARD_COST;
 }
 
 void
@@ -112,6 +113,7 @@ warthog::online_jump_point_locator::jump_south(uint32_t node_id,
 	goal_id = this->map_id_to_rmap_id(goal_id);
 	__jump_south(node_id, goal_id, jumpnode_id, jumpcost, rmap_);
 	jumpnode_id = this->rmap_id_to_map_id(jumpnode_id);
+	jumpcost *= warthog::CARD_COST;
 }
 
 void
@@ -129,6 +131,7 @@ warthog::online_jump_point_locator::jump_east(uint32_t node_id,
 		uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	__jump_east(node_id, goal_id, jumpnode_id, jumpcost, map_);
+	jumpcost *= warthog::CARD_COST;
 }
 
 
@@ -204,6 +207,7 @@ warthog::online_jump_point_locator::jump_west(uint32_t node_id,
 		uint32_t goal_id, uint32_t& jumpnode_id, warthog::cost_t& jumpcost)
 {
 	__jump_west(node_id, goal_id, jumpnode_id, jumpcost, map_);
+	jumpcost *= warthog::CARD_COST;
 }
 
 void
@@ -304,7 +308,7 @@ warthog::online_jump_point_locator::jump_northeast(uint32_t node_id,
 
 	}
 	jumpnode_id = next_id;
-	jumpcost = num_steps*warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps*warthog::DIAG_COST;
 }
 
 void
@@ -346,7 +350,7 @@ warthog::online_jump_point_locator::jump_northwest(uint32_t node_id,
 		if(!((uint64_t)cost1 && (uint64_t)cost2)) { next_id = warthog::INF32; break; }
 	}
 	jumpnode_id = next_id;
-	jumpcost = num_steps*warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps*warthog::DIAG_COST;
 }
 
 void
@@ -389,7 +393,7 @@ warthog::online_jump_point_locator::jump_southeast(uint32_t node_id,
 		if(!((uint64_t)cost1 && (uint64_t)cost2)) { next_id = warthog::INF32; break; }
 	}
 	jumpnode_id = next_id;
-	jumpcost = num_steps*warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps*warthog::DIAG_COST;
 }
 
 void
@@ -431,6 +435,6 @@ warthog::online_jump_point_locator::jump_southwest(uint32_t node_id,
 		if(!((uint64_t)cost1 && (uint64_t)cost2)) { next_id = warthog::INF32; break; }
 	}
 	jumpnode_id = next_id;
-	jumpcost = num_steps*warthog::DBL_ROOT_TWO;
+	jumpcost = num_steps*warthog::DIAG_COST;
 }
 
@@ -28,8 +28,19 @@ class online_jump_point_locator2
 {
 	public: 
 		online_jump_point_locator2(warthog::gridmap* map);
+
+		// use a rotated map created earlier by ::create_rmap. 
+		// @param rmap is not owned by the locator; this allows several 
+		// locators (e.g. one per search thread) to share one copy.
+		online_jump_point_locator2(
+				warthog::gridmap* map, warthog::gridmap* rmap);
 		~online_jump_point_locator2();
 
+		// create a copy of @param map which is rotated by 90 degrees 
+		// clockwise. the caller owns the returned object.
+		static warthog::gridmap*
+		create_rmap(warthog::gridmap* map);
+
 		void
 		jump(warthog::jps::direction d, uint32_t node_id, uint32_t goalid, 
 				std::vector<uint32_t>& jpoints,
@@ -78,6 +89,8 @@ class online_jump_point_locator2
 		// these versions can be passed a map parameter to
 		// use when jumping. they allow switching between
 		// map_ and rmap_ (a rotated counterpart).
+		// @param jumpcost: the number of steps taken; callers
+		// scale it by warthog::CARD_COST
 		void
 		__jump_north(uint32_t node_id, uint32_t goal_id, 
 				uint32_t& jumpnode_id, warthog::cost_t& jumpcost,
@@ -97,7 +110,8 @@ class online_jump_point_locator2
 
 		// these versions perform a single diagonal jump, returning
 		// the intermediate diagonal jump point and the straight 
-		// jump points that caused the jumping process to stop
+		// jump points that caused the jumping process to stop.
+		// jp1_cost and jp2_cost are step counts, as above
 		void
 		__jump_northeast(
 				uint32_t& node_id, uint32_t& rnode_id, 
@@ -155,11 +169,9 @@ class online_jump_point_locator2
 			return map_->to_padded_id(x, y);
 		}
 
-		warthog::gridmap*
-		create_rmap();
-
 		warthog::gridmap* map_;
 		warthog::gridmap* rmap_;
+		bool owns_rmap_;
 		//uint32_t jumplimit_;
 
 		uint32_t current_goal_id_;
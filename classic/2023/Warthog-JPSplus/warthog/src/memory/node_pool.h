@@ -10,8 +10,11 @@
 // are allocated in blocks of size NBS.
 // If a node from a block needs to be geneated then the 
 // entire block is allocated at the same time. 
-// Once allocated, memory is not released again until 
-// destruction. 
+// By default, once allocated, memory is not released again
+// until destruction. Long-running processes can bound the pool
+// with ::set_limits, in which case ::reclaim (called before each
+// search) recycles blocks which no recent search has used and
+// releases all memory when the pool grows beyond a given size.
 //
 // On the one hand, this approach stores successor nodes in 
 // close proximity to their parents. On the other hand, 
@@ -27,6 +30,7 @@
 #include "search_node.h"
 
 #include <stdint.h>
+#include <vector>
 
 namespace warthog
 {
@@ -58,15 +62,49 @@ class node_pool
         warthog::search_node*
         get_ptr(sn_id_t node_id);
 
+        // bound the pool: blocks whose nodes were last used @param
+        // max_idle or more searches ago are recycled, and if the pool
+        // holds more than @param max_bytes every block is released.
+        // a value of 0 disables the corresponding limit.
+        // NB: limits are only applied between searches, so a single
+        // search may still grow the pool beyond max_bytes.
+        void
+        set_limits(size_t max_bytes, uint32_t max_idle);
+
+        // apply the limits of ::set_limits before the search with
+        // number @param search_number starts. nodes from earlier
+        // searches may be released, so pointers to them are invalid
+        // afterwards. search numbers must not decrease.
+        void
+        reclaim(uint32_t search_number);
+
+        // current footprint of the pool, in bytes
 		size_t
 		mem();
 
+        // largest footprint observed at the start of a search
+        size_t
+        peak_mem();
+
 	private:
         void init(size_t nblocks);
 
+        bool
+        is_idle(warthog::search_node* block, uint32_t search_number);
+
+        void
+        release_all();
+
 		size_t num_blocks_;
 		warthog::search_node** blocks_;
 		warthog::mem::cpool* blockspool_;
+
+        // recycled blocks, reused before new memory is taken from the pool
+        std::vector<warthog::search_node*> free_blocks_;
+        size_t max_bytes_;
+        uint32_t max_idle_;
+        uint32_t last_sweep_;
+        size_t peak_bytes_;
 //        uint64_t* node_init_;
 //        uint64_t node_init_sz_;
 };
@@ -48,6 +48,10 @@ class bidirectional_search  : public warthog::search
 
             exp_cutoff_ = warthog::INF32;
             cost_cutoff_ = warthog::COST_MAX;
+            time_cutoff_nanos_ = 0;
+            v_ = 0;
+            w_ = 0;
+            best_cost_ = warthog::COST_MAX;
         }
 
         ~bidirectional_search()
@@ -126,7 +130,7 @@ class bidirectional_search  : public warthog::search
             return sizeof(*this) + 
                 fopen_->mem() +
                 bopen_->mem() +
-                fexpander_->mem();
+                fexpander_->mem() +
                 bexpander_->mem();
         }
 
@@ -298,6 +302,17 @@ class bidirectional_search  : public warthog::search
                 fopen_->push(fexpander_->generate_start_node(pi));
             }
 
+            // the searches only meet on the nodes they generate, which
+            // never includes their own start; check for a trivial instance
+            if(best_cost_ == warthog::COST_MAX &&
+               fexpander_->generate_start_node(pi)->get_id() ==
+               bexpander_->generate_target_node(pi)->get_id())
+            {
+                best_cost_ = 0;
+                v_ = fexpander_->generate_start_node(pi);
+                w_ = bexpander_->generate_target_node(pi);
+            }
+
 
             // main expansion loop 
             // (breaks when it can be proven the problem is not solvable)
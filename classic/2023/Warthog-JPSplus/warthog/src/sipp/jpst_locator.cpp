@@ -150,7 +150,7 @@ warthog::jpst_locator::jump_east(uint32_t node_id,
 {
    
    uint32_t fc_jp_id;
-   double fc_jp_cost;
+   warthog::cost_t fc_jp_cost;
 
    // jump; look for spatial jump points
    fc_jpl_->jump_east(node_id, goal_id, fc_jp_id, fc_jp_cost);
@@ -174,7 +174,7 @@ warthog::jpst_locator::jump_west(uint32_t node_id,
 		uint32_t goal_id, uint32_t& jumpnode_id, double& jumpcost)
 {
    uint32_t fc_jp_id;
-   double fc_jp_cost;
+   warthog::cost_t fc_jp_cost;
 
    // jump; look for spatial jump points
    fc_jpl_->jump_west(node_id, goal_id, fc_jp_id, fc_jp_cost);
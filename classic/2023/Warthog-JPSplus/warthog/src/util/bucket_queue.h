@@ -0,0 +1,224 @@
+#ifndef WARTHOG_BUCKET_QUEUE_H
+#define WARTHOG_BUCKET_QUEUE_H
+
+// bucket_queue.h
+//
+// A monotone min priority queue for search nodes (a radix heap).
+// Priorities are f-values scaled to 64bit integers and nodes are kept
+// in 65 buckets according to the highest bit in which their key
+// differs from the last key popped. push is O(1) and pop is amortised
+// O(1) for the small key ranges of octile grid search, compared to
+// O(log n) sifts for the binary heap in pqueue.h.
+//
+// The queue can replace pqueue_min as the open list of flexible_astar
+// provided that the f-values of generated nodes never fall below that
+// of the node being expanded (i.e. the heuristic is consistent). Keys
+// below the last popped key are clamped, which keeps the queue valid
+// but no longer strictly ordered.
+//
+// decrease_key is lazy: the node is inserted again and the older entry
+// is discarded when it reaches the front of the queue. The node's
+// priority field identifies its current entry.
+//
+// Nodes whose f-values differ by less than 1/KEY_SCALE may be popped
+// in either order; ties on f are broken last-in first-out.
+//
+
+#include "constants.h"
+#include "search_node.h"
+
+#include <cassert>
+#include <vector>
+
+namespace warthog
+{
+
+class bucket_queue
+{
+	public:
+		static constexpr double KEY_SCALE = 1 << 20;
+
+		bucket_queue(unsigned int size=1024)
+			: last_(0), queuesize_(0), stamp_(0), heap_ops_(0)
+		{ buckets_[0].reserve(size); }
+
+		~bucket_queue() { }
+
+		// removes all elements from the queue
+		void
+		clear()
+		{
+			for(std::vector<entry>& b : buckets_) { b.clear(); }
+			last_ = 0;
+			queuesize_ = 0;
+			stamp_ = 0;
+			heap_ops_ = 0;
+		}
+
+		// add a new element to the queue
+		void
+		push(warthog::search_node* val)
+		{
+			insert(val);
+			queuesize_++;
+		}
+
+		// reprioritise an element already in the queue
+		void
+		decrease_key(warthog::search_node* val)
+		{
+			insert(val);
+		}
+
+		void
+		increase_key(warthog::search_node* val)
+		{
+			insert(val);
+		}
+
+		// apply @param update to every element (e.g. to assign a new
+		// f-value) and then rebuild the queue.
+		template <class F>
+		void
+		reprioritise(F update)
+		{
+			std::vector<warthog::search_node*> live;
+			live.reserve(queuesize_);
+			for(std::vector<entry>& b : buckets_)
+			{
+				for(entry& e : b)
+				{
+					if(is_live(e)) { live.push_back(e.node_); }
+				}
+				b.clear();
+			}
+			last_ = 0;
+			for(warthog::search_node* n : live)
+			{
+				update(n);
+				insert(n);
+			}
+		}
+
+		// remove the top element from the queue
+		warthog::search_node*
+		pop()
+		{
+			assert(queuesize_ > 0);
+			settle();
+			warthog::search_node* n = buckets_[0].back().node_;
+			buckets_[0].pop_back();
+			n->set_priority(warthog::INF32);
+			queuesize_--;
+			return n;
+		}
+
+		// @return the top element (but do not remove it)
+		warthog::search_node*
+		peek()
+		{
+			if(queuesize_ == 0) { return 0; }
+			settle();
+			return buckets_[0].back().node_;
+		}
+
+		inline uint32_t
+		get_heap_ops()
+		{ return heap_ops_; }
+
+		inline uint32_t
+		size()
+		{ return queuesize_; }
+
+		inline bool
+		empty()
+		{ return queuesize_ == 0; }
+
+		inline size_t
+		mem()
+		{
+			size_t bytes = sizeof(*this);
+			for(std::vector<entry>& b : buckets_)
+			{
+				bytes += b.capacity()*sizeof(entry);
+			}
+			return bytes;
+		}
+
+	private:
+		struct entry
+		{
+			uint64_t key_;
+			uint32_t stamp_;
+			warthog::search_node* node_;
+		};
+
+		std::vector<entry> buckets_[65];
+		uint64_t last_;
+		uint32_t queuesize_;
+		uint32_t stamp_;
+		uint32_t heap_ops_;
+
+		inline uint32_t
+		bucket(uint64_t key)
+		{
+			return key == last_ ? 0 : 64 - __builtin_clzll(key ^ last_);
+		}
+
+		inline bool
+		is_live(const entry& e)
+		{
+			return e.node_->get_priority() == e.stamp_;
+		}
+
+		inline void
+		insert(warthog::search_node* val)
+		{
+			uint64_t key = (uint64_t)(val->get_f() * KEY_SCALE + 0.5);
+			if(key < last_) { key = last_; }
+			val->set_priority(++stamp_);
+			buckets_[bucket(key)].push_back(entry{key, stamp_, val});
+		}
+
+		// move the smallest live entry to the back of bucket 0
+		void
+		settle()
+		{
+			while(true)
+			{
+				std::vector<entry>& front = buckets_[0];
+				while(front.size() && !is_live(front.back()))
+				{
+					front.pop_back();
+				}
+				if(front.size()) { return; }
+
+				uint32_t i = 1;
+				while(buckets_[i].empty()) { i++; }
+				assert(i < 65);
+
+				uint64_t min = UINT64_MAX;
+				for(entry& e : buckets_[i])
+				{
+					if(is_live(e) && e.key_ < min) { min = e.key_; }
+				}
+				if(min != UINT64_MAX)
+				{
+					// every live entry now has a key sharing more leading
+					// bits with last_, so it lands in a lower bucket
+					last_ = min;
+					for(entry& e : buckets_[i])
+					{
+						if(!is_live(e)) { continue; }
+						buckets_[bucket(e.key_)].push_back(e);
+						heap_ops_++;
+					}
+				}
+				buckets_[i].clear();
+			}
+		}
+};
+
+}
+
+#endif
@@ -91,6 +91,33 @@ class pqueue
             heapify_up(priority);
         }
 
+        // apply @param update to every element (e.g. to assign a new
+        // f-value) and then restore the heap property in one pass.
+        template <class F>
+        void
+        reprioritise(F update)
+        {
+            for(unsigned int i=0; i < queuesize_; i++)
+            {
+                update(elts_[i]);
+            }
+            for(unsigned int i = queuesize_ >> 1; i > 0; i--)
+            {
+                heapify_down(i-1);
+            }
+        }
+
+        // apply @param f to every element, in no particular order
+        template <class F>
+        void
+        for_each(F f)
+        {
+            for(unsigned int i=0; i < queuesize_; i++)
+            {
+                f(elts_[i]);
+            }
+        }
+
 		// remove the top element from the pqueue
         warthog::search_node*
         pop()
@@ -26,6 +26,7 @@ SOFTWARE.
 #include "centroid.h"
 #include "Dijkstra.h"
 #include "query.h"
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 
@@ -222,6 +223,31 @@ bool GetPath(void *data, xyLoc s, xyLoc g, std::vector<xyLoc> &path) {
   return true;
 }
 
+/**
+ * Batched form of `GetPath`, see Entry.h.
+ * Queries are answered grouped by the centroid row that `GetInvCentroidCost` walks
+ * (same choice of row as there), so consecutive queries reuse the same CPD row.
+ */
+void GetPaths(void *data, const std::vector<std::pair<xyLoc, xyLoc>> &queries, std::vector<std::vector<xyLoc>> &paths) {
+  EntryData* entrydata = (EntryData*)data;
+  const Mapper& mapper = entrydata->mapper;
+  std::vector<std::pair<int, int>> order(queries.size());
+  for (int i=0; i<(int)queries.size(); i++) {
+    xyLoc s = queries[i].first, g = queries[i].second;
+    int cs = mapper.get_fa()[mapper(s)], cg = mapper.get_fa()[mapper(g)];
+    xyLoc cxs = mapper(cs), cxg = mapper(cg);
+    int row = abs(s.x - cxg.x) + abs(s.y - cxg.y) < abs(g.x - cxs.x) + abs(g.y - cxs.y) ? cg : cs;
+    order[i] = {mapper.get_centroid_rank(row), i};
+  }
+  std::sort(order.begin(), order.end());
+
+  paths.resize(queries.size());
+  for (auto& it: order) {
+    paths[it.second].clear();
+    GetPath(data, queries[it.second].first, queries[it.second].second, paths[it.second]);
+  }
+}
+
 /**
  * The algorithm name.  Please update std::string and ensure name is immutable.
  * 